@@ -111,10 +111,10 @@ void lwcli_task(void *pvparameters)
         #else
         receive_length = lwcli_receive(receive_buffer, LWCLI_RECEIVE_BUFFER_SIZE, portMAX_DELAY);
         #endif
-        for (int i = 0; i < receive_length; i++)
-        {
-            lwcli_process_receive_char(receive_buffer[i]);
-        }
+        lwcli_process_receive_buffer(receive_buffer, receive_length);
+        #if (LWCLI_DEFERRED_INPUT == LWCLI_TRUE)
+        lwcli_poll();   /* 延迟模式下也可以在串口中断中调用 lwcli_process_receive_char()，这里只负责处理 */
+        #endif
     }
 }
 
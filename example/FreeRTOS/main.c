@@ -7,11 +7,20 @@
 /* FreeRTOS 平台接口实现（用户可替换为 UART 等） */
 static void *opt_malloc(size_t size) { return pvPortMalloc(size); }
 static void opt_free(void *ptr) { vPortFree(ptr); }
+#if (LWCLI_ASYNC_OUTPUT == LWCLI_TRUE)
+static void opt_output(const char *s, uint16_t len) {
+    /* TODO: 替换为 UART DMA 发送，启动后立即返回，s 在发送完成前保持有效 */
+    HAL_UART_Transmit_DMA(&huart1, (const uint8_t *)s, len);
+}
+/* 发送完成中断：通知 lwcli 可以交出下一块缓冲区 */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) { lwcli_output_done(); }
+#else
 static void opt_output(const char *s, uint16_t len) {
     /* TODO: 替换为 UART 发送 */
     if (len == 1) putchar(*s);
     else printf("%.*s", len, s);
 }
+#endif  // LWCLI_ASYNC_OUTPUT == LWCLI_TRUE
 #if (LWCLI_WITH_FILE_SYSTEM == true)
 static char *opt_get_file_path(void) { return "/"; }
 #endif
@@ -21,22 +30,24 @@ static char *opt_get_file_path(void) { return "/"; }
  * @note 当输入"test 123 456 -789"时，会打印"123 456 -789"
  * @param argc 参数数量
  * @param argv 参数数组 
+ * @param argl 参数长度数组
  */
-void test_command_callback(int argc, char* argv[])
+void test_command_callback(int argc, char* argv[], const uint16_t argl[])
 {
     for (int i = 0; i < argc; i++)
     {
-        printf("%s ", argv[i]);// 打印所有参数
+        lwcli_printf("%s ", argv[i]);// 打印所有参数
     }
-    printf("\r\n");
+    lwcli_print("\r\n");
 }
 
 /**
  * @brief FreeRTOS任务监控
  * @param argc 
  * @param argv 
+ * @param argl 
  */
-void system_command_callback(int argc, char *argv[])
+void system_command_callback(int argc, char *argv[], const uint16_t argl[])
 {
     char *task_info_buffer = NULL;
     uint16_t task_info_buffer_pos = 0;
@@ -62,7 +73,7 @@ void system_command_callback(int argc, char *argv[])
             strcpy( task_info_buffer + task_info_buffer_pos, pcHeader );
             task_info_buffer_pos += strlen( pcHeader );
             vTaskList( task_info_buffer + task_info_buffer_pos );
-            printf("%s", task_info_buffer); 
+            lwcli_print(task_info_buffer);
             vPortFree( task_info_buffer );
         }
     }
@@ -18,82 +18,121 @@ static char *opt_get_file_path(void) { return "/"; }
 #endif
 
 #if (LWCLI_PARAMETER_SPLIT == LWCLI_TRUE)
-#define LWCLI_STRSTR(n, str) strstr(argv[n], str)
 
-
-void test_func(int argc, char *argv[])
+void test_func(int argc, char *argv[], const uint16_t argl[])
 {
-    printf("argc = %d\n", argc);
+    lwcli_printf("argc = %d\r\n", argc);
     for (int i = 0; i < argc; i++)
     {
-        printf("%s, ", argv[i]);
+        lwcli_printf("%s, ", argv[i]);
     }
-    printf("\n");
+    lwcli_print("\r\n");
 }
 
-void echo_func(int argc, char *argv[])
+void echo_func(int argc, char *argv[], const uint16_t argl[])
 {
     for (int i = 0; i < argc; i++)
     {
-        printf("%s ", argv[i]);
+        lwcli_write(argv[i], argl[i]);
+        lwcli_write(" ", 1);
     }
-    printf("\n");
+    lwcli_print("\r\n");
 }
 
-void date_func(int argc, char *argv[])
+static void date_print(void)
 {
     struct tm *timeinfo = NULL;
     time_t rawtime = 0;
     char buffer[80];
     time(&rawtime);
     timeinfo = localtime(&rawtime);
-    if (argc == 0)
-    {
-        // 格式化时间字符串
-        strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", timeinfo);
-        printf("格式化时间: %s\n", buffer);
-        
-        // 更多格式选项
-        strftime(buffer, sizeof(buffer), "%A, %B %d, %Y %I:%M:%S %p", timeinfo);
-        printf("详细格式: %s\n", buffer);
+
+    // 格式化时间字符串
+    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", timeinfo);
+    lwcli_printf("格式化时间: %s\r\n", buffer);
+
+    // 更多格式选项
+    strftime(buffer, sizeof(buffer), "%A, %B %d, %Y %I:%M:%S %p", timeinfo);
+    lwcli_printf("详细格式: %s\r\n", buffer);
+}
+
+void date_func(int argc, char *argv[], const uint16_t argl[])
+{
+    date_print();
+}
+
+void date_get_func(int argc, char *argv[], const uint16_t argl[])
+{
+    date_print();
+}
+
+#if (LWCLI_USING_HOTKEY == LWCLI_TRUE)
+/* Ctrl+T 热键：不输入命令直接打印时间 */
+void date_hotkey(uint8_t key)
+{
+    date_print();
+}
+#endif  // LWCLI_USING_HOTKEY == LWCLI_TRUE
+
+void date_set_func(int argc, char *argv[], const uint16_t argl[])
+{
+    if (argc != 1) {
+        lwcli_print("usage: date set \"2026/01/18 14:22:53\"\r\n");
+        return;
     }
-    if (argc == 1)
-    {
-        if (LWCLI_STRSTR(0, "get") != NULL){
-            // 格式化时间字符串
-            strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", timeinfo);
-            printf("格式化时间: %s\n", buffer);
-            
-            // 更多格式选项
-            strftime(buffer, sizeof(buffer), "%A, %B %d, %Y %I:%M:%S %p", timeinfo);
-            printf("详细格式: %s\n", buffer);
-        }
+    struct tm time_set;
+    sscanf(argv[0], "%04d/%02d/%02d %02d:%02d:%02d", &time_set.tm_year, &time_set.tm_mon, &time_set.tm_mday, &time_set.tm_hour, &time_set.tm_min, &time_set.tm_sec);
+    if (time_set.tm_year > 2000 && time_set.tm_mon < 13 && time_set.tm_hour < 24 && time_set.tm_min < 60 && time_set.tm_sec < 60){
+        lwcli_printf("date set success %s\r\n", argv[0]);
     }
-    if (argc == 2){
-        if (LWCLI_STRSTR(0, "set")){
-            char time_buf[30];
-            struct tm time_set;
-            sscanf(argv[1], "\"%04d/%02d/%02d %02d:%02d:%02d\"", &time_set.tm_year, &time_set.tm_mon, &time_set.tm_mday, &time_set.tm_hour, &time_set.tm_min, &time_set.tm_sec);
-            if (time_set.tm_year > 2000 && time_set.tm_mon < 13 && time_set.tm_hour < 24 && time_set.tm_min < 60 && time_set.tm_sec < 60){
-                printf("date set success %s\n", argv[1]);
-            }
-            else{
-                printf("date set error, time format invaild\n");
-            }
-        }
+    else{
+        lwcli_print("date set error, time format invaild\r\n");
     }
 }
 
-void ls_func(int argc, char *argv[])
+#if (LWCLI_USING_RAW_MODE == LWCLI_TRUE)
+/* upload <长度>：之后的数据不回显，直接交给 upload_consumer，Ctrl+D 提前结束 */
+static size_t upload_size = 0;
+
+void upload_consumer(const char *data, size_t len, int last)
+{
+    upload_size += len;
+    if (last) {
+        lwcli_printf("received %zu bytes\r\n", upload_size);
+        upload_size = 0;
+    }
+}
+
+void upload_func(int argc, char *argv[], const uint16_t argl[])
+{
+    size_t length = (argc > 0) ? strtoul(argv[0], NULL, 0) : 0;
+    lwcli_raw_begin(upload_consumer, length, 0x04);
+}
+#endif  // LWCLI_USING_RAW_MODE == LWCLI_TRUE
+
+void ls_func(int argc, char *argv[], const uint16_t argl[])
 {
     if (argc){
-        printf("call by ls [%s]\r\n", argv[0]);
+        lwcli_printf("call by ls [%s]\r\n", argv[0]);
     }   
     else {
-        printf("call by ls \r\n");
+        lwcli_print("call by ls \r\n");
     }
 }
 
+#if (LWCLI_USING_COMMAND_EXPORT == LWCLI_TRUE)
+/* 仿照linux系统提供的ls命令，以静态命令表导出（存放于 flash，不占用堆内存） */
+static const lwcli_parameter_t ls_parameters[] = {
+    {"-a", "do not ignore entries starting with", 0},
+    {"-i", "print the index number of each file", 0},
+    {"-l", "use a long listing format", 0},
+    {"-u", "with -lt: sort by, and show, access time;\r\n"
+           "\twith -l: show access time and sort by name;\r\n"
+           "\totherwise: sort by access time, newest first", 0},
+};
+LWCLI_COMMAND_EXPORT_WITH_PARAMETER("ls", "List information about the FILEs", ls_func, ls_parameters);
+#endif  // LWCLI_USING_COMMAND_EXPORT == LWCLI_TRUE
+
 int main(void)
 {
     system("stty -icanon");
@@ -110,9 +149,10 @@ int main(void)
     lwcli_hardware_init(&opt);
     lwcli_software_init();
     int command_fd = 0;
-    command_fd = lwcli_regist_command("date", "get or set time", date_func);
-    lwcli_regist_command_parameter(command_fd, "get", "get data info");
-    lwcli_regist_command_parameter(command_fd, "set", "change date info of system, like: set \"2026/01/18 14:22:53\"\r\n");
+    /* 子命令：date get / date set 由 lwcli 分发，回调无需再比较参数字符串 */
+    lwcli_regist_command("date", "get or set time", date_func);
+    lwcli_regist_command("date get", "get data info", date_get_func);
+    lwcli_regist_command("date set", "change date, like: date set \"2026/01/18 14:22:53\"", date_set_func);
 
     command_fd = lwcli_regist_command("test2", "test command2", test_func);
     lwcli_regist_command_parameter(command_fd, "para1", "test paramter fix");
@@ -120,15 +160,13 @@ int main(void)
     lwcli_regist_command_parameter(command_fd, "para3", "test paramter fix");
     lwcli_regist_command("test3", "test command3", test_func);
     lwcli_regist_command("test4", "test command4", test_func);
+#if (LWCLI_USING_HOTKEY == LWCLI_TRUE)
+    lwcli_regist_hotkey(LWCLI_HOTKEY_CTRL('t'), date_hotkey);
+#endif  // LWCLI_USING_HOTKEY == LWCLI_TRUE
+#if (LWCLI_USING_RAW_MODE == LWCLI_TRUE)
+    lwcli_regist_command("upload", "receive raw data, like: upload 1024", upload_func);
+#endif  // LWCLI_USING_RAW_MODE == LWCLI_TRUE
 
-    /* 仿照linux系统提供的ls命令注册参数 */
-    command_fd = lwcli_regist_command("ls", "List information about the FILEs", ls_func);
-    lwcli_regist_command_parameter(command_fd, "-l", "use a long listing format");
-    lwcli_regist_command_parameter(command_fd, "-i", "print the index number of each file");
-    lwcli_regist_command_parameter(command_fd, "-a", "do not ignore entries starting with");
-    lwcli_regist_command_parameter(command_fd, "-u", "with -lt: sort by, and show, access time;\r\n"
-                                                "\twith -l: show access time and sort by name;\r\n"
-                                                "\totherwise: sort by access time, newest first");
     while(1)
     {
         lwcli_process_receive_char(getchar());
@@ -141,22 +179,22 @@ int main(void)
 
 void test_func(char *argvs)
 {
-    printf("argvs = %s\n", argvs);
+    lwcli_printf("argvs = %s\r\n", argvs);
 }
 
 void echo_func(char *argvs)
 {
-    printf("argvs = %s\n", argvs);
+    lwcli_printf("argvs = %s\r\n", argvs);
 }
 
 void date_func(char *argvs)
 {
-    printf("argvs = %s\n", argvs);
+    lwcli_printf("argvs = %s\r\n", argvs);
 }
 
 void ls_func(char *argvs)
 {
-    printf("argvs = %s\n", argvs);
+    lwcli_printf("argvs = %s\r\n", argvs);
 }
 
 int main(void)
@@ -17,6 +17,7 @@
 
 #include "stdint.h"
 #include "stddef.h"
+#include "stdarg.h"
 #include "lwcli_config.h"
 
 #define LWCLI_VERSION "V0.0.4"
@@ -56,9 +57,13 @@ void lwcli_software_init(void);
 /**
  * @brief 用户命令回调函数类型（参数分割模式）
  * @param argc  传入命令的参数个数（不含命令名本身）
- * @param argv  参数字符串数组（argv[0] 为第一个参数）
+ * @param argv  参数字符串数组（argv[0] 为第一个参数，argv[argc] 为 NULL）
+ * @param argl  各参数的长度，argl[i] == strlen(argv[i])
+ *
+ * @note 参数直接指向输入缓冲区，已去除双引号并处理反斜杠转义（如 "a b"、a\ b 均为 a b），
+ *       仅在回调期间有效。
  */
-typedef void (*user_callback_f)(int argc, char *argv[]);
+typedef void (*user_callback_f)(int argc, char *argv[], const uint16_t argl[]);
 #else
 /**
  * @brief 用户命令回调函数类型（原始字符串模式）
@@ -67,17 +72,134 @@ typedef void (*user_callback_f)(int argc, char *argv[]);
 typedef void (*user_callback_f)(char *argvs);
 #endif
 
+/**
+ * @brief 参数描述符（用于帮助显示与 Tab 补全）
+ */
+typedef struct lwcli_parameter {
+    const char *parameter;      /**< 参数字符串（如 "<on|off>"、"-h"、"get"） */
+    const char *description;    /**< 该参数的详细说明（可为 NULL） */
+    uint8_t position;           /**< 仅在第 position 个参数处补全（从 1 开始），0 表示任意位置 */
+} lwcli_parameter_t;
+
+/**
+ * @brief 命令描述符
+ * @note 可定义为 const 常量存放于 flash，通过 LWCLI_COMMAND_EXPORT() 或
+ *       lwcli_regist_command_table() 注册，注册过程不分配堆内存、不拷贝字符串。
+ */
+typedef struct lwcli_command {
+    const char *command;                    /**< 命令字符串 */
+    const char *brief;                      /**< 在 "help" 列表中显示的简短帮助 */
+    user_callback_f callback;               /**< 命令回调函数 */
+    const lwcli_parameter_t *parameters;    /**< 参数表（可为 NULL） */
+    uint16_t parameter_num;                 /**< 参数表元素个数 */
+} lwcli_command_t;
+
+#if (LWCLI_USING_COMMAND_EXPORT == LWCLI_TRUE)
+#define LWCLI_EXPORT_CONCAT_(a, b)  a##b
+#define LWCLI_EXPORT_CONCAT(a, b)   LWCLI_EXPORT_CONCAT_(a, b)
+#define LWCLI_EXPORT_ATTRIBUTE      __attribute__((used, section("lwcli_command"), aligned(sizeof(void *))))
+
+/**
+ * @brief 导出静态命令（链接到 lwcli_command 段，由 lwcli_software_init() 自动注册）
+ * @param command  命令字符串
+ * @param brief    简短帮助
+ * @param callback 回调函数
+ *
+ * @note 用法：LWCLI_COMMAND_EXPORT("reboot", "reboot system", reboot_func);
+ */
+#define LWCLI_COMMAND_EXPORT(command, brief, callback) \
+    static const lwcli_command_t LWCLI_EXPORT_CONCAT(lwcli_command_, __LINE__) LWCLI_EXPORT_ATTRIBUTE = \
+        {(command), (brief), (callback), NULL, 0}
+
+/**
+ * @brief 导出带参数表的静态命令
+ * @param parameter_table lwcli_parameter_t 常量数组（非指针，元素个数由 sizeof 计算）
+ *
+ * @note 参数表须先按 position、再按参数字符串升序排列，补全时二分查找；未排序的表注册失败。
+ */
+#define LWCLI_COMMAND_EXPORT_WITH_PARAMETER(command, brief, callback, parameter_table) \
+    static const lwcli_command_t LWCLI_EXPORT_CONCAT(lwcli_command_, __LINE__) LWCLI_EXPORT_ATTRIBUTE = \
+        {(command), (brief), (callback), (parameter_table), sizeof(parameter_table) / sizeof((parameter_table)[0])}
+#endif  // LWCLI_USING_COMMAND_EXPORT == LWCLI_TRUE
+
 /**
  * @brief 注册新命令
- * @param command       命令字符串（如 "led"、"system reboot"）
+ * @param command       命令字符串（如 "led"、"sys reset"），完整路径长度须小于 LWCLI_COMMAND_STR_MAX_LENGTH
  * @param brief         在 "help" 列表中显示的简短帮助（一行）
  * @param user_callback 命令被调用时执行的回调函数
  * @return              成功返回命令描述符（句柄），失败返回负值
  * 
  * @note 返回的描述符可用于 lwcli_regist_command_help() 附加详细用法和说明。
+ * @note 以单个空格分隔的多个 token 注册为子命令，如 "sys reset"、"sys stat"：
+ *       分发、help 与 Tab 补全逐级查找，回调只收到子命令之后的参数。
+ *       上级命令 "sys" 未注册时自动创建，单独输入时列出其子命令；
+ *       也可以注册 "sys" 自身的回调，输入的 token 不是子命令时作为其参数。
  */
 int lwcli_regist_command(const char *command, const char *brief, user_callback_f user_callback);
 
+/**
+ * @brief 注册静态命令表
+ * @param table 命令描述符数组（通常为 const，存放于 flash），注册后须一直有效
+ * @param num   数组元素个数
+ * @return      成功注册的命令个数，参数错误返回负值
+ *
+ * @note 仅引用描述符，不分配堆内存、不拷贝字符串；可与 lwcli_regist_command() 混合使用。
+ *       静态命令的参数由描述符中的参数表提供，不可再调用 lwcli_regist_command_parameter()。
+ */
+int lwcli_regist_command_table(const lwcli_command_t *table, uint16_t num);
+
+/**
+ * @brief 注销命令
+ * @param command_fd lwcli_regist_command() 返回的命令描述符
+ *
+ * @note 运行时注册的命令及其参数的内存随之释放；静态命令只从命令表中移除。
+ *       仍有子命令的命令变为命令组，其子命令不受影响。其他命令的描述符保持不变，
+ *       被注销命令的描述符可能被之后注册的命令复用。
+ * @note 只访问命令路径上的节点（哈希索引后移删除，不重建），另需一次 O(命令总数) 的有序索引压缩，
+ *       只搬移 2 字节下标，不比较字符串。
+ */
+void lwcli_unregist_command(int command_fd);
+
+#if (LWCLI_USING_MODULE == LWCLI_TRUE)
+/** 默认模块，始终挂载 */
+#define LWCLI_MODULE_DEFAULT 0
+
+/**
+ * @brief 选择之后注册的命令所属的模块
+ * @param module 模块编号（0 ~ LWCLI_MODULE_MAX_NUM - 1），默认为 LWCLI_MODULE_DEFAULT
+ *
+ * @note 用法：lwcli_module_select(DIAG_MODULE); 注册诊断命令 ...; lwcli_module_select(LWCLI_MODULE_DEFAULT);
+ *       不同模块的命令可共用自动创建的上级命令；若上级命令本身属于某个模块，卸载该模块后其子命令也不可达。
+ */
+void lwcli_module_select(uint8_t module);
+
+/**
+ * @brief 挂载模块，其命令重新参与分发、help 与 Tab 补全
+ * @param module 模块编号
+ *
+ * @note 新注册的模块默认已挂载，O(1)。
+ */
+void lwcli_module_attach(uint8_t module);
+
+/**
+ * @brief 卸载模块，其命令不再参与分发、help 与 Tab 补全
+ * @param module 模块编号，不可为 LWCLI_MODULE_DEFAULT
+ *
+ * @note O(1)，只清除模块位图，命令仍占用命令表与内存，可再次挂载。
+ */
+void lwcli_module_detach(uint8_t module);
+
+/**
+ * @brief 注销模块中的全部命令并释放其内存
+ * @param module 模块编号，不可为 LWCLI_MODULE_DEFAULT
+ *
+ * @note 命令从命令表中移除，分发与补全不再受其影响；需要再次使用时重新注册。
+ *       通过模块链表只遍历本模块的命令，耗时为 O(模块命令数 × 命令深度)，
+ *       外加一次 O(命令总数) 的有序索引压缩；会释放内存，不应在中断中调用。
+ */
+void lwcli_module_release(uint8_t module);
+#endif  // LWCLI_USING_MODULE == LWCLI_TRUE
+
 #if (LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE)
 /**
  * @brief 为命令注册参数（用于帮助显示与 Tab 补全）
@@ -89,8 +211,110 @@ int lwcli_regist_command(const char *command, const char *brief, user_callback_f
  *       并可后续用于智能 Tab 补全。
  */
 void lwcli_regist_command_parameter(int command_fd, const char *parameter, const char *description);
+
+/**
+ * @brief 为命令注册只在指定参数位置补全的参数
+ * @param command_fd  lwcli_regist_command() 返回的命令描述符
+ * @param position    参数位置，从 1 开始（如 "date set <fmt>" 中 <fmt> 为 2），0 表示任意位置
+ * @param parameter   参数字符串
+ * @param description 该参数的详细说明（可为 NULL）
+ *
+ * @note 补全第 N 个参数时只在第 N 位置与任意位置的参数中查找。
+ *       参数按序插入：乱序逐个注册 n 个参数共移动 O(n^2) 个元素，参数较多时请使用
+ *       lwcli_regist_command_parameter_table() 或静态命令表。
+ */
+void lwcli_regist_command_parameter_at(int command_fd, uint8_t position, const char *parameter, const char *description);
+
+/**
+ * @brief 为命令批量注册参数
+ * @param command_fd  lwcli_regist_command() 返回的命令描述符
+ * @param table       参数表，须按 (position, parameter) 升序排列
+ * @param num         参数表元素个数
+ * @return            成功注册的参数个数，失败返回 -1（已注册的参数不变）
+ *
+ * @note 与已注册的参数一次归并，已有 n 个、新增 m 个参数时为 O(n + m)。
+ *       字符串的拷贝规则与 lwcli_regist_command_parameter() 相同。
+ */
+int lwcli_regist_command_parameter_table(int command_fd, const lwcli_parameter_t *table, uint16_t num);
 #endif
 
+#if (LWCLI_USING_HOTKEY == LWCLI_TRUE)
+/**
+ * @brief Ctrl + 字母的热键编码，如 LWCLI_HOTKEY_CTRL('s') 为 Ctrl+S（0x13）
+ * @note Ctrl+H、I、J、M、[（退格、Tab、换行、回车、ESC）用于行编辑，不能绑定
+ */
+#define LWCLI_HOTKEY_CTRL(c)    ((uint8_t)((c) & 0x1F))
+
+/**
+ * @brief 功能键热键编码（由转义序列解码得到），Ctrl 热键编码为 0x01 - 0x1F
+ */
+typedef enum {
+    LWCLI_HOTKEY_F1 = 0x20,
+    LWCLI_HOTKEY_F2,
+    LWCLI_HOTKEY_F3,
+    LWCLI_HOTKEY_F4,
+    LWCLI_HOTKEY_F5,
+    LWCLI_HOTKEY_F6,
+    LWCLI_HOTKEY_F7,
+    LWCLI_HOTKEY_F8,
+    LWCLI_HOTKEY_F9,
+    LWCLI_HOTKEY_F10,
+    LWCLI_HOTKEY_F11,
+    LWCLI_HOTKEY_F12,
+    LWCLI_HOTKEY_NUM,
+} lwcli_hotkey_e;
+
+/**
+ * @brief 热键回调函数类型
+ * @param key 触发的热键编码
+ */
+typedef void (*lwcli_hotkey_f)(uint8_t key);
+
+/**
+ * @brief 绑定热键
+ * @param key      LWCLI_HOTKEY_CTRL(c) 或 lwcli_hotkey_e
+ * @param callback 回调函数，NULL 表示解除绑定
+ * @return         成功返回 0，热键编码无效或为行编辑保留的按键返回 -1
+ *
+ * @note 按下热键时在接收路径中直接查表调用回调，不经过命令行解析，也不记入历史；
+ *       正在编辑的命令行保持不变，回调返回后重绘。回调的输出应以 "\r\n" 结尾。
+ */
+int lwcli_regist_hotkey(uint8_t key, lwcli_hotkey_f callback);
+#endif  // LWCLI_USING_HOTKEY == LWCLI_TRUE
+
+#if (LWCLI_USING_RAW_MODE == LWCLI_TRUE)
+/** lwcli_raw_begin() 不使用结束字节 */
+#define LWCLI_RAW_NO_TERMINATOR     (-1)
+
+/**
+ * @brief 原始数据接收回调类型
+ * @param data 接收到的数据块（不含结束字节）
+ * @param len  数据长度
+ * @param last true 表示已达到指定长度或收到结束字节，原始模式已结束
+ */
+typedef void (*lwcli_raw_f)(const char *data, size_t len, int last);
+
+/**
+ * @brief 进入原始数据模式
+ * @param consumer   数据接收回调，不可为 NULL
+ * @param length     最多接收的字节数，0 表示不限
+ * @param terminator 结束字节（如 0x04），LWCLI_RAW_NO_TERMINATOR 表示不使用
+ * @return           成功返回 0，参数错误或已处于原始模式返回 -1
+ *
+ * @note 通常在命令回调中调用（如固件/校准表上传）。之后接收到的数据不经过行编辑、
+ *       回显与历史，按块直接交给 consumer，直到达到 length、收到 terminator 或调用
+ *       lwcli_raw_end()，然后重新显示提示符。
+ * @note 终端以 "\r\n" 结束命令行时，紧随其后的 '\n' 会被当作原始数据。
+ * @note 括号粘贴中的命令进入原始模式时，其后粘贴的行（换行为 '\n'，空行被忽略）交给 consumer。
+ */
+int lwcli_raw_begin(lwcli_raw_f consumer, size_t length, int terminator);
+
+/**
+ * @brief 退出原始数据模式并重新显示提示符（不调用 consumer）
+ */
+void lwcli_raw_end(void);
+#endif  // LWCLI_USING_RAW_MODE == LWCLI_TRUE
+
 /**
  * @brief 处理一个接收到的字符
  * @param recv_char  来自 UART/USB/终端的输入字符
@@ -100,6 +324,80 @@ void lwcli_regist_command_parameter(int command_fd, const char *parameter, const
  */
 void lwcli_process_receive_char(char recv_char);
 
+/**
+ * @brief 处理一段接收到的数据
+ * @param buf  来自 UART DMA/USB/终端的输入数据
+ * @param len  数据长度
+ * 
+ * @note 与逐字节调用 lwcli_process_receive_char() 效果相同，但光标位于行尾时
+ *       连续的普通字符只做一次拷贝和一次回显，适合 DMA 或任务按块接收的场景。
+ */
+void lwcli_process_receive_buffer(const char *buf, size_t len);
+
+/**
+ * @brief 向终端输出格式化字符串
+ * @param format 格式字符串，支持 %d %i %u %o %x %X %c %s %p %%，标志 '-' '0' '+' ' '，宽度与 %s 精度（数字或 *），
+ *               长度修饰 hh h l z；ll、整数精度与 '#' 需启用 LWCLI_PRINTF_EXTENDED（否则 ll 取走参数后原样输出）；
+ *               不支持浮点（%f 等取走参数后原样输出）
+ *
+ * @note 命令、热键与原始模式回调应使用 lwcli_printf()/lwcli_print()/lwcli_write() 输出，
+ *       输出经过 opt->output 与 lwcli 的合并缓冲区，与随后的提示符一起发送；长度不受缓冲区限制。
+ */
+void lwcli_printf(const char *format, ...);
+
+/**
+ * @brief 同 lwcli_printf()，参数以 va_list 传入
+ * @param format 格式字符串
+ * @param args 参数
+ */
+void lwcli_vprintf(const char *format, va_list args);
+
+/**
+ * @brief 向终端输出字符串
+ * @param str 以 '\0' 结尾的字符串
+ */
+void lwcli_print(const char *str);
+
+/**
+ * @brief 向终端输出指定长度的数据（可不以 '\0' 结尾，如 argv[i] 与 argl[i]）
+ * @param data 数据
+ * @param len 长度
+ */
+void lwcli_write(const char *data, uint16_t len);
+
+#if (LWCLI_WRITE_COMBINE == LWCLI_TRUE)
+/**
+ * @brief 立即输出合并缓冲区中的内容
+ *
+ * @note 启用 LWCLI_WRITE_COMBINE 时，lwcli 处理输入期间的输出先合并，交互结束、调用用户回调之前
+ *       或缓冲区满时自动输出，通常无需手动调用。
+ */
+void lwcli_flush(void);
+#endif  // LWCLI_WRITE_COMBINE == LWCLI_TRUE
+
+#if (LWCLI_ASYNC_OUTPUT == LWCLI_TRUE)
+/**
+ * @brief 通知 lwcli 上一次 opt->output 交出的缓冲区已发送完成
+ *
+ * @note 启用 LWCLI_ASYNC_OUTPUT 时 opt->output 只需启动发送即可返回，发送完成中断中调用此函数，
+ *       lwcli 才会交出下一块缓冲区。在 output 内部同步发送完毕后直接调用也可以。
+ */
+void lwcli_output_done(void);
+#endif  // LWCLI_ASYNC_OUTPUT == LWCLI_TRUE
+
+#if (LWCLI_DEFERRED_INPUT == LWCLI_TRUE)
+/**
+ * @brief 处理已接收的输入
+ *
+ * @note 启用 LWCLI_DEFERRED_INPUT 时，lwcli_process_receive_char() 与 lwcli_process_receive_buffer()
+ *       只把数据写入 LWCLI_INPUT_RING_SIZE 大小的环形缓冲区：每字节最坏为一次比较、一次写入与
+ *       下标回绕，与行长度、命令数量无关，不输出也不调用任何回调。
+ *       行编辑、回显、重绘、补全、热键与命令分发全部在本函数中执行，应在任务或主循环中周期调用。
+ * @note 接收函数与本函数之间无需加锁（单生产者/单消费者），但接收函数不可在多个上下文中同时调用。
+ */
+void lwcli_poll(void);
+#endif  // LWCLI_DEFERRED_INPUT == LWCLI_TRUE
+
 
 #ifdef __cplusplus
     }
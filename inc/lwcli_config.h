@@ -27,18 +27,83 @@
 
 /**
  * @brief 命令字符串最大长度
- * @note 用于命令匹配的长度，不含参数。例如 "system -t" 和 "system reboot" 均匹配为 "system"，
- *       命令长度为 strlen("system")。
+ * @note 限制的是完整命令路径的长度，含子命令与分隔空格，不含参数，且须小于本值。
+ *       例如注册了 "sys reset" 时，"sys reset -f" 的命令长度为 strlen("sys reset") = 9；
+ *       未注册子命令时 "sys -t" 和 "sys reset" 均匹配为 "sys"。
+ *       使用较长的多级子命令时须相应调大，最大 255。
  */
 #define LWCLI_COMMAND_STR_MAX_LENGTH 10
 
 /**
  * @brief 帮助/简介字符串最大长度
+ * @note 仅用于注册时的长度检查，不再决定命令结构体大小
  */
 #define LWCLI_BRIEF_MAX_LENGTH 100
 
 /**
- * @brief 接收/输入缓冲区大小
+ * @brief 是否允许以唯一前缀缩写输入命令
+ * @note 1/true: 如 "reb" 直接执行 "reboot"；有多个命令以输入开头时列出候选命令。
+ *       子命令同样适用（如 "sys reb"）。Tab 补全不受影响
+ */
+#define LWCLI_COMMAND_ABBREVIATION LWCLI_FALSE
+
+/**
+ * @brief 命令名是否忽略大小写
+ * @note 1/true: "HELP" 与 "help" 匹配为同一命令，仅大小写不同的命令不能重复注册；参数不受影响
+ */
+#define LWCLI_COMMAND_IGNORE_CASE LWCLI_FALSE
+
+/**
+ * @brief 是否启用零拷贝注册
+ * @note 1/true:  lwcli_regist_command()/lwcli_regist_command_parameter() 只保存字符串指针，
+ *                调用者须保证字符串一直有效（如字符串常量，存放于 flash）
+ *       0/false: 字符串按实际长度拷贝到堆，注销命令时释放
+ */
+#define LWCLI_REGIST_ZERO_COPY LWCLI_FALSE
+
+/**
+ * @brief 是否启用命令模块
+ * @note 命令按模块分组，整个模块可在运行时以 O(1) 挂载/卸载（lwcli_module_attach/detach），
+ *       或通过 lwcli_module_release() 注销并释放内存
+ */
+#define LWCLI_USING_MODULE LWCLI_TRUE
+
+#if (LWCLI_USING_MODULE == LWCLI_TRUE)
+/**
+ * @brief 最大模块数量
+ * @note 最大 32，模块 0 为默认模块，始终挂载
+ */
+#define LWCLI_MODULE_MAX_NUM 8
+#endif  // LWCLI_USING_MODULE == LWCLI_TRUE
+
+/**
+ * @brief 最大命令数量（含内置 help、clear，以及注册子命令时自动创建的上级命令）
+ * @note 命令热数据表按此容量静态分配，最大 65534；
+ *       32 位平台每条命令约占用 24 字节（热数据 16 字节 + 有序索引 2 字节 + 命令树链接 6 字节），
+ *       启用模块时约 32 字节（热数据 20 字节，另加模块链表 4 字节）
+ */
+#define LWCLI_COMMAND_MAX_NUM 32
+
+/**
+ * @brief 命令哈希索引槽位数
+ * @note 必须为 2 的幂且大于 LWCLI_COMMAND_MAX_NUM，建议取 LWCLI_COMMAND_MAX_NUM 的 2 倍，
+ *       每个槽位占用 2 字节
+ */
+#define LWCLI_COMMAND_HASH_SIZE 64
+
+/**
+ * @brief 是否启用 LWCLI_COMMAND_EXPORT() 静态命令导出
+ * @note 依赖编译器 section 属性（GCC/Clang/ARMCC），导出的命令放入 "lwcli_command" 段，
+ *       lwcli_software_init() 通过段起止符号直接注册。
+ * @note GNU ld 会为该段自动生成 __start_lwcli_command/__stop_lwcli_command；
+ *       自定义链接脚本时需在只读段中加入 KEEP(*(lwcli_command)) 并定义上述两个符号。
+ */
+#define LWCLI_USING_COMMAND_EXPORT LWCLI_TRUE
+
+/**
+ * @brief 接收/输入缓冲区大小（单行命令最大长度 + 1）
+ * @note 行编辑使用间隙缓冲区，行中插入、删除与光标移动不随行长增加开销，
+ *       粘贴长配置行时可设为数 KB，最大 65535
  */
 #define LWCLI_RECEIVE_BUFFER_SIZE 50
 
@@ -52,9 +117,85 @@
 #define LWCLI_HISTORY_COMMAND_NUM 10
 
 /**
- * @brief 格式化终端输出的缓冲区大小
+ * @brief 是否延迟处理输入
+ * @note 1/true: lwcli_process_receive_char()/lwcli_process_receive_buffer() 只把数据写入环形缓冲区，
+ *       每字节 O(1)、不输出、不调用回调，可在高优先级中断中调用；行编辑、重绘与命令分发在 lwcli_poll() 中执行
+ */
+#define LWCLI_DEFERRED_INPUT LWCLI_FALSE
+
+#if (LWCLI_DEFERRED_INPUT == LWCLI_TRUE)
+/**
+ * @brief 输入环形缓冲区大小（2 的幂），须容纳两次 lwcli_poll() 之间接收的数据，满时丢弃新数据
+ */
+#define LWCLI_INPUT_RING_SIZE 256
+#endif  // LWCLI_DEFERRED_INPUT == LWCLI_TRUE
+
+/**
+ * @brief 是否合并输出
+ * @note 处理一次输入期间的输出先写入合并缓冲区，在交互结束（显示提示符）、缓冲区满或调用 lwcli_flush() 时
+ *       才调用 opt->output，大幅减少串口/USB 传输次数；回调中经 lwcli_printf()/lwcli_print()/lwcli_write()
+ *       的输出与提示符合并发送
+ */
+#define LWCLI_WRITE_COMBINE LWCLI_TRUE
+
+#if (LWCLI_WRITE_COMBINE == LWCLI_TRUE)
+/**
+ * @brief 命令/热键/原始模式回调是否绕过 lwcli 直接输出（如 printf）
+ * @note 启用后调用回调前先输出合并缓冲区（异步输出时并等待发送完成），保证先后顺序
+ */
+#define LWCLI_CALLBACK_DIRECT_OUTPUT LWCLI_FALSE
+
+/**
+ * @brief 输出合并缓冲区大小
+ */
+#define LWCLI_WRITE_BUFFER_SIZE 256
+
+/**
+ * @brief 是否使用异步输出
+ * @note 启用后 opt->output 只需启动发送（如 DMA）即可返回，发送完成时调用 lwcli_output_done()（可在中断中调用）；
+ *       发送期间交给 output 的缓冲区保持不变，lwcli 在另一块缓冲区中继续填充，占用 2 * LWCLI_WRITE_BUFFER_SIZE 字节
+ */
+#define LWCLI_ASYNC_OUTPUT LWCLI_FALSE
+
+#if (LWCLI_ASYNC_OUTPUT == LWCLI_TRUE)
+/**
+ * @brief 等待上一块缓冲区发送完成时循环执行的语句，如 RTOS 中可设为 taskYIELD()
+ */
+#define LWCLI_OUTPUT_WAIT()
+#endif  // LWCLI_ASYNC_OUTPUT == LWCLI_TRUE
+#endif  // LWCLI_WRITE_COMBINE == LWCLI_TRUE
+
+#if (LWCLI_WRITE_COMBINE == LWCLI_FALSE)
+#define LWCLI_ASYNC_OUTPUT LWCLI_FALSE    // 异步输出依赖合并缓冲区
+#endif  // LWCLI_WRITE_COMBINE == LWCLI_FALSE
+
+/**
+ * @brief 是否启用括号粘贴（xterm bracketed paste）
+ * @note 启用后初始化时发送 ESC[?2004h，终端用 ESC[200~ / ESC[201~ 包裹粘贴内容；
+ *       粘贴内容不逐字符回显，直接插入输入行，完整的命令行按顺序排队，粘贴结束后执行并只重绘一次
+ */
+#define LWCLI_BRACKETED_PASTE LWCLI_TRUE
+
+#if (LWCLI_BRACKETED_PASTE == LWCLI_TRUE)
+/**
+ * @brief 粘贴命令队列大小
+ * @note 存放粘贴内容中已完整的命令行，队列满时先执行已排队的命令
+ */
+#define LWCLI_PASTE_QUEUE_SIZE 256
+#endif  // LWCLI_BRACKETED_PASTE == LWCLI_TRUE
+
+/**
+ * @brief 格式化输出的分块大小
+ * @note lwcli 内部的流式格式化在栈上攒满这么多字节就交给输出，输出长度不受此限制
  */
-#define LWCLI_SHELL_OUTPUT_BUFFER_SIZE 512
+#define LWCLI_PRINTF_CHUNK_SIZE 32
+
+/**
+ * @brief 格式化输出是否支持扩展格式
+ * @note 1/true:  另外支持 ll 长度修饰、整数精度（如 %.4d）与 '#' 标志（%#x %#o）
+ *       0/false: 只支持常用子集，ll 转换取走参数后原样输出，不引入 64 位除法库函数
+ */
+#define LWCLI_PRINTF_EXTENDED LWCLI_FALSE
 
 /**
  * @brief 是否启用参数分割/提取
@@ -74,19 +215,39 @@
 #define LWCLI_PARAMETER_COMPLETION LWCLI_FALSE
 #endif  // LWCLI_PARAMETER_SPLIT == LWCLI_FALSE
 
+#if (LWCLI_PARAMETER_SPLIT == LWCLI_TRUE)
+/**
+ * @brief 单条命令最多传给回调的参数个数
+ * @note 输入时逐字符记录参数边界，超出的参数被忽略
+ */
+#define LWCLI_PARAMETER_MAX_NUM 16
+#endif  // LWCLI_PARAMETER_SPLIT == LWCLI_TRUE
+
+/**
+ * @brief 是否启用热键（Ctrl + 字母、F1 - F12 绑定回调，按下立即执行）
+ * @note 通过 lwcli_regist_hotkey() 绑定，适合切换日志、输出统计、紧急停止等即时操作
+ */
+#define LWCLI_USING_HOTKEY LWCLI_TRUE
+
+/**
+ * @brief 是否启用原始数据模式
+ * @note 命令可通过 lwcli_raw_begin() 接管之后的输入，数据不经过行编辑与回显直接按块交给回调，
+ *       用于固件、校准表等批量上传
+ */
+#define LWCLI_USING_RAW_MODE LWCLI_TRUE
+
 /**
- * @brief 运行时动态内存池大小
- * @note 用于 Tab 补全、参数分割等运行时临时分配
+ * @brief 是否在输入时为命令名着色
+ * @note 输入过程中增量解析命令行，命令名可识别时显示为绿色，否则显示为红色
  */
-#define LWCLI_DYNAMIC_POOL_SIZE 256
+#define LWCLI_COMMAND_HIGHLIGHT LWCLI_FALSE
 
-#if (LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE)
 /**
- * @brief 存储已注册参数字符串的内存池大小
- * @note 用于存储已注册参数字符串
+ * @brief 字符串扫描与比较是否按机器字（32/64 位）处理
+ * @note 用于参数扫描、命令比较与补全公共前缀；不支持非对齐访问的内核（如 Cortex-M0）建议关闭，
+ *       关闭后使用逐字节实现
  */
-#define LWCLI_STATIC_POOL_SIZE 512
-#endif  // LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE
+#define LWCLI_STRING_SWAR LWCLI_TRUE
 
 /**
  * @brief 是否启用文件系统风格提示符
@@ -0,0 +1,70 @@
+/**
+ * @file lwcli_string.h
+ * @brief lwcli 内部字符串内核：空格/引号扫描、前缀比较与公共前缀
+ *
+ * LWCLI_STRING_SWAR 启用时按机器字（32/64 位，随指针宽度）一次处理多个字节，
+ * 否则使用逐字节的可移植实现。所有接口都带长度，不依赖 '\0'，也不会越过 len 读取。
+ */
+
+#ifndef __LWCLI_STRING_H__
+#define __LWCLI_STRING_H__
+
+#include <stdint.h>
+#include "lwcli_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 计算 s 开头连续等于 c 的字节数（如跳过空格）
+ * @param s 字符串
+ * @param len 长度
+ * @param c 目标字节
+ * @return 连续字节数，不超过 len
+ */
+uint16_t lwcli_str_skip(const char *s, uint16_t len, char c);
+
+/**
+ * @brief 查找第一个等于 c 的字节（如查找空格）
+ * @param s 字符串
+ * @param len 长度
+ * @param c 目标字节
+ * @return 下标，未找到返回 len
+ */
+uint16_t lwcli_str_find(const char *s, uint16_t len, char c);
+
+/**
+ * @brief 查找第一个等于 a、b、c 之一的字节（如查找空格、引号、反斜杠）
+ * @param s 字符串
+ * @param len 长度
+ * @param a 目标字节 a
+ * @param b 目标字节 b
+ * @param c 目标字节 c
+ * @return 下标，未找到返回 len
+ */
+uint16_t lwcli_str_find3(const char *s, uint16_t len, char a, char b, char c);
+
+/**
+ * @brief 计算 a、b 前 len 个字节的公共前缀长度
+ * @param a 字符串 a
+ * @param b 字符串 b
+ * @param len 最大比较长度
+ * @return 第一个不同字节的下标，完全相同返回 len
+ */
+uint16_t lwcli_str_mismatch(const char *a, const char *b, uint16_t len);
+
+/**
+ * @brief 比较 a、b 的前 len 个字节，语义同 memcmp
+ * @param a 字符串 a
+ * @param b 字符串 b
+ * @param len 比较长度
+ * @return <0 / 0 / >0
+ */
+int lwcli_str_compare(const char *a, const char *b, uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LWCLI_STRING_H__ */
@@ -9,8 +9,7 @@
  * 
  */
 #include "lwcli.h"
-#include "lwcli_list.h"
-#include "stdio.h"
+#include "lwcli_string.h"
 #include "stdbool.h"
 #include "stdlib.h"
 #include "string.h"
@@ -18,55 +17,97 @@
 #include "stdarg.h"
 #include "ctype.h"
 
-#define LWCLI_MEMPOOL_DEFINE(name, buffer_size) \
-    typedef struct { \
-        char data[buffer_size]; \
-        uint32_t size; \
-        uint32_t pos; \
-    } name##_pool_t; \
-    static name##_pool_t name##_pool = {.size = buffer_size, .pos = 0};
-
-#define LWCLI_POOL_ALLOC(pool_name, size) \
-    (lwcli_pool_alloc(&(pool_name##_pool.data[0]), &(pool_name##_pool.size), &(pool_name##_pool.pos), (size)))
-#define LWCLI_POOL_FREE(pool_name) ((pool_name##_pool.pos) = 0)
+#if ((LWCLI_COMMAND_HASH_SIZE & (LWCLI_COMMAND_HASH_SIZE - 1)) != 0) || (LWCLI_COMMAND_HASH_SIZE <= LWCLI_COMMAND_MAX_NUM)
+#error "LWCLI_COMMAND_HASH_SIZE must be a power of 2 and greater than LWCLI_COMMAND_MAX_NUM"
+#endif
+#if (LWCLI_COMMAND_MAX_NUM > 65534)
+#error "LWCLI_COMMAND_MAX_NUM must not exceed 65534"
+#endif
+#if (LWCLI_DEFERRED_INPUT == LWCLI_TRUE) && (((LWCLI_INPUT_RING_SIZE & (LWCLI_INPUT_RING_SIZE - 1)) != 0) || (LWCLI_INPUT_RING_SIZE > 32768))
+#error "LWCLI_INPUT_RING_SIZE must be a power of 2 and not exceed 32768"
+#endif
+#if (LWCLI_RECEIVE_BUFFER_SIZE > 65535)
+#error "LWCLI_RECEIVE_BUFFER_SIZE must not exceed 65535"
+#endif
+#if (LWCLI_COMMAND_STR_MAX_LENGTH > 255)
+#error "LWCLI_COMMAND_STR_MAX_LENGTH must not exceed 255"
+#endif
+#if (LWCLI_USING_MODULE == LWCLI_TRUE) && (LWCLI_MODULE_MAX_NUM > 32)
+#error "LWCLI_MODULE_MAX_NUM must not exceed 32"
+#endif
+
+/** 比较整个字符串时使用的比较长度 **/
+#define LWCLI_COMPARE_WHOLE         (0xFFFFu)
+
+/** FNV-1a 哈希，可逐字符累加 **/
+#define LWCLI_HASH_INIT             (2166136261u)
+#define LWCLI_HASH_STEP(hash, c)    (((hash) ^ (uint8_t)(c)) * 16777619u)
+/** 命令树节点的哈希以父节点编号为种子，同名子命令在不同层级互不冲突 **/
+#define LWCLI_HASH_SEED(parent)     LWCLI_HASH_STEP(LWCLI_HASH_STEP(LWCLI_HASH_INIT, (parent) & 0xFF), (parent) >> 8)
+
+/** 命令名比较前的大小写折叠，哈希、排序与比较均使用折叠后的字符 **/
+#if (LWCLI_COMMAND_IGNORE_CASE == LWCLI_TRUE)
+#define LWCLI_CASE_FOLD(c)          ((char)tolower((uint8_t)(c)))
+#else
+#define LWCLI_CASE_FOLD(c)          (c)
+#endif  // LWCLI_COMMAND_IGNORE_CASE == LWCLI_TRUE
 
-static inline char *lwcli_pool_alloc(char *data, uint32_t *pool_size, uint32_t *pool_pos, uint32_t size)
+/**
+ * @brief 运行时注册命令的存储
+ * @note desc 必须为第一个成员，热数据中的描述符指针可直接转换回 command_t
+ * @note 零拷贝模式下 command/brief 直接指向调用者的字符串；
+ *       拷贝模式下字符串按实际长度紧跟在结构体之后，与结构体一次分配
+ */
+typedef struct command
 {
-    char *ptr = NULL;
-    if ((*pool_size - *pool_pos) >= size) {
-        ptr = data + *pool_pos;
-        *pool_pos += size;
-    }
-    return ptr;
-}
+    lwcli_command_t desc;   /**< 描述符 */
+    uint16_t parameter_cap; /**< 参数数组容量 */
+} command_t;
 
-LWCLI_MEMPOOL_DEFINE(dynamic, LWCLI_DYNAMIC_POOL_SIZE);
+#define LWCLI_COMMAND_FLAG_DYNAMIC  (0x01)  /**< 运行时注册，描述符位于 command_t 内 */
+#define LWCLI_COMMAND_FLAG_GROUP    (0x02)  /**< 注册子命令时自动创建的中间节点，无回调，desc 借用首个子命令的描述符 */
+#define LWCLI_COMMAND_FLAG_FREE     (0x04)  /**< 空闲槽位，parent 为空闲链表的下一个槽位 */
 
-#if (LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE)
-typedef struct parameter_list
+/**
+ * @brief 命令热数据：分发时只访问此表，连续存放
+ * @note 命令按空格分隔的 token 组成命令树（如 "sys reset" 为 "sys" 的子节点 "reset"），
+ *       每个节点以 (父节点, token) 为键存放于同一个哈希索引中，逐级查找
+ */
+typedef struct
 {
-    char *data;
-    uint8_t len;
-    char *description;
-    list_node_t node;
-} parameter_t;
+    uint32_t hash;                  /**< (父节点, token) 哈希 */
+    user_callback_f callback;       /**< 用户回调，中间节点为 NULL */
+    const lwcli_command_t *desc;    /**< 指向冷数据（名称、简介、参数） */
+    uint16_t parent;                /**< 父节点热数据下标 + 1，0 为根 */
+    uint8_t cmd_len;                /**< 完整命令路径长度（如 "sys reset" 为 9） */
+    uint8_t flags;                  /**< LWCLI_COMMAND_FLAG_xxx */
+#if (LWCLI_USING_MODULE == LWCLI_TRUE)
+    uint8_t module;                 /**< 所属模块 */
+#endif  // LWCLI_USING_MODULE == LWCLI_TRUE
+} command_hot_t;
 
-LWCLI_MEMPOOL_DEFINE(parameter, LWCLI_STATIC_POOL_SIZE);
-#endif  // LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE
-
-typedef struct command
+/**
+ * @brief 命令槽位的双向链表链接，存放热数据下标 + 1，0 为空
+ */
+typedef struct
 {
-    char command[LWCLI_COMMAND_STR_MAX_LENGTH];
-    char brief[LWCLI_BRIEF_MAX_LENGTH];
-
-#if (LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE)
-    parameter_t para;   /* 参数链表头，仅使用 para.node，data/len/description 未使用 */
-#endif  // LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE
-
-    uint8_t cmd_len;
-    user_callback_f callback;
-    list_node_t node;
-} command_t;
+    uint16_t next;
+    uint16_t prev;
+} command_link_t;
+
+#if (LWCLI_USING_COMMAND_EXPORT == LWCLI_TRUE)
+#if defined(__CC_ARM) || (defined(__ARMCC_VERSION) && (__ARMCC_VERSION >= 6010050))
+extern const int lwcli_command$$Base;
+extern const int lwcli_command$$Limit;
+#define LWCLI_EXPORT_SECTION_START  ((const lwcli_command_t *)&lwcli_command$$Base)
+#define LWCLI_EXPORT_SECTION_END    ((const lwcli_command_t *)&lwcli_command$$Limit)
+#else
+extern const lwcli_command_t __start_lwcli_command[] __attribute__((weak));
+extern const lwcli_command_t __stop_lwcli_command[] __attribute__((weak));
+#define LWCLI_EXPORT_SECTION_START  (&__start_lwcli_command[0])
+#define LWCLI_EXPORT_SECTION_END    (&__stop_lwcli_command[0])
+#endif
+#endif  // LWCLI_USING_COMMAND_EXPORT == LWCLI_TRUE
 
 #if (LWCLI_HISTORY_COMMAND_NUM > 0)
 typedef struct
@@ -116,49 +157,184 @@ static char *colorTable[] = {
 
 #endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
 
+/**
+ * @brief 命令行的增量解析状态
+ * @note 输入字符追加到行尾时逐字符更新，Enter 分发与 Tab 补全直接使用，无需重新扫描整行；
+ *       其他编辑只置 dirty，使用前整行重新解析一次
+ */
+typedef struct
+{
+    bool dirty;                     /**< 状态与输入行不一致，使用前需重新解析 */
+    bool inToken;                   /**< 最后一个字符位于 token 中 */
+    bool inQuotes;                  /**< 处于双引号中，空格不分隔 token */
+    bool escaped;                   /**< 上一个字符为反斜杠，当前字符按字面处理 */
+    bool cmdDone;                   /**< 命令路径已结束，之后的 token 均为参数 */
+    uint16_t parsedLen;             /**< 已解析的字符数 */
+    uint16_t tokenStart;            /**< 当前 token 的起始下标 */
+    uint32_t tokenHash;             /**< 当前 token 的增量哈希，以所在层的父节点为种子 */
+    uint16_t parent;                /**< 已匹配命令路径的末端节点（热数据下标 + 1），0 为根 */
+    uint16_t cmdEnd;                /**< 已匹配命令路径在行中的结束下标 */
+    uint16_t firstEnd;              /**< 第一个 token（命令名）的结束下标，未结束时为 0 */
+#if (LWCLI_PARAMETER_SPLIT == LWCLI_TRUE)
+    uint16_t argc;                  /**< 已确定的参数个数 */
+    uint16_t argStart[LWCLI_PARAMETER_MAX_NUM];   /**< 参数起始下标 */
+    uint16_t argEnd[LWCLI_PARAMETER_MAX_NUM];     /**< 参数结束下标，最后一个参数未结束时为 0 */
+#endif  // LWCLI_PARAMETER_SPLIT == LWCLI_TRUE
+}lwcli_line_t;
+
+/** 转义序列解析状态 **/
+typedef enum
+{
+    LWCLI_ANSI_STATE_NONE = 0,
+    LWCLI_ANSI_STATE_ESC,       /**< 已收到 ESC */
+    LWCLI_ANSI_STATE_CSI,       /**< ESC [ 参数 ... 结束字符 */
+    LWCLI_ANSI_STATE_SS3,       /**< ESC O 结束字符 */
+}lwcli_ansi_state_e;
+
+#if (LWCLI_COMMAND_HIGHLIGHT == LWCLI_TRUE)
+/** 命令名着色 **/
+typedef enum
+{
+    LWCLI_HIGHLIGHT_NONE = 0,
+    LWCLI_HIGHLIGHT_VALID,      /**< 可识别的命令（含命令组） */
+    LWCLI_HIGHLIGHT_INVALID,    /**< 无法识别 */
+}lwcli_highlight_e;
+#endif  // LWCLI_COMMAND_HIGHLIGHT == LWCLI_TRUE
+
+/** 转义序列解码后的按键 **/
+typedef enum
+{
+    LWCLI_KEY_NONE = 0,
+    LWCLI_KEY_UP,
+    LWCLI_KEY_DOWN,
+    LWCLI_KEY_RIGHT,
+    LWCLI_KEY_LEFT,
+    LWCLI_KEY_HOME,
+    LWCLI_KEY_END,
+    LWCLI_KEY_DELETE,
+    LWCLI_KEY_WORD_RIGHT,
+    LWCLI_KEY_WORD_LEFT,
+    LWCLI_KEY_PASTE_BEGIN,
+    LWCLI_KEY_PASTE_END,
+    LWCLI_KEY_F1,           /**< F1 - F12 连续排列，作为热键分发 */
+    LWCLI_KEY_F12 = LWCLI_KEY_F1 + 11,
+    LWCLI_KEY_NUM,
+}lwcli_key_e;
+
 typedef struct 
 {
     const lwcli_opt_t *opt;   /**< 用户注入的接口（由 lwcli_hardware_init 注册）*/
-    command_t *command;
-    uint8_t command_num;
+    bool initialized;
+    uint16_t command_num;                                   /**< 已注册的命令数量（有序索引长度） */
+    uint16_t command_used;                                  /**< 热数据表已使用的槽位数（含空闲槽位） */
+    uint16_t command_free;                                  /**< 空闲槽位链表头（下标 + 1），0 为空 */
+    uint16_t command_free_num;                              /**< 空闲槽位数量 */
+#if (LWCLI_USING_MODULE == LWCLI_TRUE)
+    uint32_t module_attached;                               /**< 已挂载模块位图 */
+    uint8_t module_current;                                 /**< 新注册命令所属的模块 */
+    uint16_t module_head[LWCLI_MODULE_MAX_NUM];             /**< 各模块命令链表头（下标 + 1） */
+    command_link_t command_module[LWCLI_COMMAND_MAX_NUM];   /**< 同一模块命令的双向链表，不含中间节点，注销模块时只遍历本模块 */
+#endif  // LWCLI_USING_MODULE == LWCLI_TRUE
+    command_hot_t command_hot[LWCLI_COMMAND_MAX_NUM];       /**< 命令热数据表，下标为 command_fd - 1 */
+    uint16_t command_index[LWCLI_COMMAND_HASH_SIZE];        /**< 开放寻址哈希索引，存放热数据下标 + 1，0 为空槽 */
+    uint16_t command_sorted[LWCLI_COMMAND_MAX_NUM];         /**< 按 (父节点, token) 升序排列的热数据下标，同层子命令连续，注册时维护 */
+    uint16_t command_root;                                  /**< 第一级命令链表头（下标 + 1） */
+    uint16_t command_child[LWCLI_COMMAND_MAX_NUM];          /**< 各节点的首个子节点（下标 + 1），0 表示没有子节点 */
+    command_link_t command_sibling[LWCLI_COMMAND_MAX_NUM];  /**< 同一父节点下的兄弟节点双向链表，注销时逐级回收中间节点 */
     /** 输入输出缓冲区 **/
     char inputBuffer[LWCLI_RECEIVE_BUFFER_SIZE];
-    char ouputBuffer[LWCLI_SHELL_OUTPUT_BUFFER_SIZE];
     uint16_t inputBufferPos;
     uint16_t cursorPos;
+    lwcli_line_t line;                                      /**< 输入行的增量解析状态 */
+#if (LWCLI_COMMAND_HIGHLIGHT == LWCLI_TRUE)
+    uint8_t highlightColor;                                 /**< 屏幕上命令名的颜色（lwcli_highlight_e） */
+    uint16_t highlightLen;                                  /**< 屏幕上已着色的命令名长度 */
+#endif  // LWCLI_COMMAND_HIGHLIGHT == LWCLI_TRUE
+    uint8_t ansiState;                                      /**< 转义序列解析状态（lwcli_ansi_state_e），跨调用保持 */
+    uint8_t ansiParamNum;                                   /**< 当前累加的 CSI 参数下标 */
+    uint16_t ansiParam[2];                                  /**< CSI 数字参数，如 ESC[1;5C 为 {1, 5} */
+#if (LWCLI_BRACKETED_PASTE == LWCLI_TRUE)
+    bool pasting;                                           /**< 处于 ESC[200~ 与 ESC[201~ 之间 */
+    uint16_t pasteQueueLen;                                 /**< 粘贴队列已用长度 */
+    char pasteQueue[LWCLI_PASTE_QUEUE_SIZE];                /**< 粘贴得到的完整命令行，以 '\0' 分隔 */
+#endif  // LWCLI_BRACKETED_PASTE == LWCLI_TRUE
+#if (LWCLI_USING_HOTKEY == LWCLI_TRUE)
+    lwcli_hotkey_f hotkey[LWCLI_HOTKEY_NUM];                /**< 热键回调表，下标为热键编码 */
+#endif  // LWCLI_USING_HOTKEY == LWCLI_TRUE
+#if (LWCLI_USING_RAW_MODE == LWCLI_TRUE)
+    lwcli_raw_f rawConsumer;                                /**< 原始模式的数据接收回调，NULL 表示未处于原始模式 */
+    size_t rawRemain;                                       /**< 原始模式剩余可接收的字节数，0 表示不限 */
+    int16_t rawTerminator;                                  /**< 原始模式结束字节，LWCLI_RAW_NO_TERMINATOR 表示不使用 */
+#endif  // LWCLI_USING_RAW_MODE == LWCLI_TRUE
+#if (LWCLI_DEFERRED_INPUT == LWCLI_TRUE)
+    volatile uint16_t ringHead;                             /**< 输入环形缓冲区写位置，只由接收函数修改 */
+    volatile uint16_t ringTail;                             /**< 输入环形缓冲区读位置，只由 lwcli_poll() 修改 */
+    char ring[LWCLI_INPUT_RING_SIZE];                       /**< 输入环形缓冲区 */
+#endif  // LWCLI_DEFERRED_INPUT == LWCLI_TRUE
+#if (LWCLI_WRITE_COMBINE == LWCLI_TRUE)
+    uint8_t outputHold;                                     /**< 交互嵌套深度，大于 0 时输出进入合并缓冲区 */
+    uint16_t writeLen;                                      /**< 合并缓冲区已用长度 */
+#if (LWCLI_ASYNC_OUTPUT == LWCLI_TRUE)
+    volatile uint8_t outputBusy;                            /**< 已交给 output 的缓冲区尚未发送完成 */
+    uint8_t writeIndex;                                     /**< 正在填充的缓冲区下标 */
+    char writeBuffer[2][LWCLI_WRITE_BUFFER_SIZE];           /**< 输出双缓冲区，一块发送时填充另一块 */
+#else
+    char writeBuffer[LWCLI_WRITE_BUFFER_SIZE];              /**< 输出合并缓冲区 */
+#endif  // LWCLI_ASYNC_OUTPUT == LWCLI_TRUE
+#endif  // LWCLI_WRITE_COMBINE == LWCLI_TRUE
 
 #if (LWCLI_HISTORY_COMMAND_NUM > 0)
     historyList_t historyList; // 历史记录表
 #endif  // LWCLI_HISTORY_COMMAND_NUM > 0
-
-#if (LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE)
-    int help_fd;
-#endif  // LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE
 }lwcli_t;
 
 static lwcli_t lwcliObj = {0};
 
 /** 静态函数声明 **/
 #if (LWCLI_PARAMETER_SPLIT == LWCLI_TRUE)
-static void lwcli_help(int argc, char *argv[]);
-static void lwcli_clear(int argc, char *argv[]);
+static void lwcli_help(int argc, char *argv[], const uint16_t argl[]);
+static void lwcli_clear(int argc, char *argv[], const uint16_t argl[]);
 #else
 static void lwcli_help(char *argvs);
 static void lwcli_clear(char *argvs);
 #endif  // LWCLI_PARAMETER_SPLIT == LWCLI_TRUE
-static void lwcli_process_command(char *command);
-#if (LWCLI_PARAMETER_SPLIT == LWCLI_TRUE)
-static uint8_t lwcli_find_parameters(const char *argv_str, char **parameter_arry, uint8_t parameter_num);
-static uint8_t lwcli_get_parameter_number(const char *command_string);
-#endif  // LWCLI_PARAMETER_SPLIT == LWCLI_TRUE
-static void lwcli_printf(const char *format, ...);
+static void lwcli_process_command(char *command, const lwcli_line_t *line);
+static void lwcli_line_reset(lwcli_line_t *line);
+static void lwcli_line_parse(lwcli_line_t *line, const char *text, uint16_t from, uint16_t to);
+static void lwcli_line_sync(void);
+static command_hot_t *lwcli_line_command(const lwcli_line_t *line, const char *text, bool abbreviate, uint16_t *cmd_end);
+#if (LWCLI_COMMAND_HIGHLIGHT == LWCLI_TRUE)
+static void lwcli_highlight_update(void);
+#endif  // LWCLI_COMMAND_HIGHLIGHT == LWCLI_TRUE
+#if (LWCLI_USING_HOTKEY == LWCLI_TRUE) || (LWCLI_USING_RAW_MODE == LWCLI_TRUE) || (LWCLI_BRACKETED_PASTE == LWCLI_TRUE)
+static void lwcli_input_redraw(void);
+#endif  // LWCLI_USING_HOTKEY || LWCLI_USING_RAW_MODE || LWCLI_BRACKETED_PASTE
+static inline bool lwcli_raw_active(void);
+#if (LWCLI_USING_RAW_MODE == LWCLI_TRUE)
+static size_t lwcli_raw_input(const char *buf, size_t len);
+#endif  // LWCLI_USING_RAW_MODE == LWCLI_TRUE
+static command_hot_t *lwcli_find_command(const char *input, uint16_t *input_len, bool abbreviate);
+static command_hot_t *lwcli_find_child(uint16_t parent, const char *token, uint16_t len);
+static command_hot_t *lwcli_resolve_child(uint16_t parent, const char *token, uint16_t len);
+static command_hot_t *lwcli_find_node(uint16_t parent, const char *token, uint16_t len);
+static uint32_t lwcli_token_hash(uint16_t parent, const char *token, uint16_t len);
+static command_hot_t *lwcli_find_node_hash(uint16_t parent, uint32_t hash, const char *token, uint16_t len);
+static command_hot_t *lwcli_resolve_child_hash(uint16_t parent, uint32_t hash, const char *token, uint16_t len);
+static int lwcli_command_insert(const lwcli_command_t *desc, uint8_t flags);
+static void lwcli_command_sort_insert(uint16_t from);
+static void lwcli_command_sort(void);
+static void lwcli_command_remove(uint16_t index);
+static void lwcli_command_compact(void);
+static uint16_t lwcli_command_prefix_range(uint16_t parent, const char *prefix, uint16_t prefix_len, uint16_t *first);
+static void lwcli_output_subcommands(uint16_t parent);
+static uint16_t lwcli_command_visible_range(uint16_t *first, uint16_t *num);
 static void lwcli_table_process(void);
-static void lwcli_fix_command(void);
+static void lwcli_fix_command(uint16_t parent, uint16_t token_start);
 
 #if (LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE)
-static void lwcli_fix_parameter(command_t *cmd);
-static void lwcli_get_current_parameter_prefix(command_t *cmd, const char **prefix, int *prefix_len, uint16_t *prefix_start_pos);
-static char *lwcli_parameter_malloc(uint32_t size);
+static int lwcli_parameter_compare(const lwcli_parameter_t *param, uint8_t position, const char *str, size_t len);
+static void lwcli_fix_parameter(const command_hot_t *hot, uint16_t cmd_end);
+static void lwcli_get_current_parameter_prefix(const lwcli_line_t *line, uint16_t cmd_end, const char **prefix, int *prefix_len, uint16_t *prefix_start_pos, uint8_t *position);
 #endif  // LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE
 
 #if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
@@ -167,7 +343,7 @@ static void lwcli_output_file_path(void);
 #endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
 
 #if (LWCLI_HISTORY_COMMAND_NUM > 0)
-static void lwcli_add_history_command(void);
+static void lwcli_add_history_command(const char *command, uint16_t len);
 static void lwcli_history_command_down(void);
 static void lwcli_history_command_up(void);
 #endif  // LWCLI_HISTORY_COMMAND_NUM > 0
@@ -175,25 +351,114 @@ static void lwcli_history_command_up(void);
 /** 通过 opt 调用的接口宏 **/
 #define lwcli_opt_malloc(s)      (lwcliObj.opt->malloc(s))
 #define lwcli_opt_free(p)         (lwcliObj.opt->free(p))
+#if (LWCLI_WRITE_COMBINE == LWCLI_TRUE)
+#define lwcli_opt_output(s, l)   lwcli_output_write(s, l)
+
+/**
+ * @brief 输出到合并缓冲区
+ * @note 处理输入期间（outputHold > 0）的输出先合并，交互结束、调用用户回调前或缓冲区满时一次性输出；
+ *       其他时候（如注册命令时的错误信息）直接输出
+ * @param str 字符串
+ * @param len 长度
+ */
+static void lwcli_output_write(const char *str, uint16_t len)
+{
+#if (LWCLI_ASYNC_OUTPUT == LWCLI_TRUE)
+    /* 异步输出时 output 返回后数据仍在发送，所有输出都须经过缓冲区 */
+    while (len > 0) {
+        uint16_t n = LWCLI_WRITE_BUFFER_SIZE - lwcliObj.writeLen;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(lwcliObj.writeBuffer[lwcliObj.writeIndex] + lwcliObj.writeLen, str, n);
+        lwcliObj.writeLen += n;
+        str += n;
+        len -= n;
+        if (lwcliObj.writeLen == LWCLI_WRITE_BUFFER_SIZE) {
+            lwcli_flush();
+        }
+    }
+    if (lwcliObj.outputHold == 0) {
+        lwcli_flush();
+    }
+#else
+    if (lwcliObj.outputHold == 0) {
+        lwcliObj.opt->output(str, len);
+        return;
+    }
+    if (len > sizeof(lwcliObj.writeBuffer) - lwcliObj.writeLen) {
+        lwcli_flush();
+        if (len >= sizeof(lwcliObj.writeBuffer)) {
+            lwcliObj.opt->output(str, len);
+            return;
+        }
+    }
+    memcpy(lwcliObj.writeBuffer + lwcliObj.writeLen, str, len);
+    lwcliObj.writeLen += len;
+#endif  // LWCLI_ASYNC_OUTPUT == LWCLI_TRUE
+}
+
+/**
+ * @brief 开始一次交互，之后的输出进入合并缓冲区（可嵌套）
+ */
+static inline void lwcli_output_hold(void)
+{
+    lwcliObj.outputHold++;
+}
+
+/**
+ * @brief 结束一次交互，最外层结束时输出合并缓冲区
+ */
+static inline void lwcli_output_release(void)
+{
+    if (--lwcliObj.outputHold == 0) {
+        lwcli_flush();
+    }
+}
+#else
 #define lwcli_opt_output(s, l)   (lwcliObj.opt->output(s, l))
+#define lwcli_output_hold()
+#define lwcli_output_release()
+#endif  // LWCLI_WRITE_COMBINE == LWCLI_TRUE
+
+/** 回调绕过 lwcli 直接输出时，调用前输出已合并的内容，保证与回调自身输出的先后顺序 **/
+#if (LWCLI_WRITE_COMBINE == LWCLI_TRUE) && (LWCLI_CALLBACK_DIRECT_OUTPUT == LWCLI_TRUE)
+#if (LWCLI_ASYNC_OUTPUT == LWCLI_TRUE)
+/* 回调直接使用同一端口输出，需等待已交出的缓冲区发送完成 */
+#define lwcli_flush_before_callback()   do { lwcli_flush(); while (lwcliObj.outputBusy) { LWCLI_OUTPUT_WAIT(); } } while (0)
+#else
+#define lwcli_flush_before_callback()   lwcli_flush()
+#endif  // LWCLI_ASYNC_OUTPUT == LWCLI_TRUE
+#else
+#define lwcli_flush_before_callback()
+#endif  // LWCLI_CALLBACK_DIRECT_OUTPUT == LWCLI_TRUE
 
 
 
 /** ANSI序列 **/
 static const char ansi_delete = '\177';
-static const char ansi_cursor_left[] = "\033[D";
 static const char ansi_cursor_right[] = "\033[C";
-static const char ansi_cursor_up[] = "\033[A";
-static const char ansi_cursor_down[] = "\033[B";
+static const char ansi_cursor_left_n[] = "\033[%uD";
+static const char ansi_cursor_right_n[] = "\033[%uC";
+#if (LWCLI_COMMAND_HIGHLIGHT == LWCLI_TRUE)
+static const char ansi_highlight_reset[] = "\x1B[0m";
+static const char *const ansi_highlight_color[] = {"", "\x1B[32m", "\x1B[31m"};     /**< 下标为 lwcli_highlight_e */
+#endif  // LWCLI_COMMAND_HIGHLIGHT == LWCLI_TRUE
+#if (LWCLI_BRACKETED_PASTE == LWCLI_TRUE)
+static const char ansi_paste_enable[] = "\033[?2004h";
+#endif  // LWCLI_BRACKETED_PASTE == LWCLI_TRUE
 static const char ansi_clear_screen[] = "\033[2J";
+#if (LWCLI_USING_HOTKEY == LWCLI_TRUE) || (LWCLI_USING_RAW_MODE == LWCLI_TRUE) || (LWCLI_BRACKETED_PASTE == LWCLI_TRUE)
 static const char ansi_clear_line[] = "\033[2K\r";
+#endif  // LWCLI_USING_HOTKEY || LWCLI_USING_RAW_MODE || LWCLI_BRACKETED_PASTE
 static const char ansi_clear_behind[] = "\033[K";
-static const char ansi_cursor_save[] = "\033[s";
-static const char ansi_cursor_restore[] = "\033[u";
 static const char ansi_cursor_move_to[] = "\033[%d;%dH";
 
+/** 输出 ANSI 序列，不含结尾的 '\0' **/
+#define lwcli_output_ansi(seq)   lwcli_opt_output(seq, sizeof(seq) - 1)
+
 /** 其他字符串定义 **/
-static const char lwcli_delete[] = "\b \b";
+static const char lwcli_backspaces[] = "\b\b\b\b";    /**< 短距离左移用退格，比 ESC[nD 更短 */
 static const char lwcli_reminder[] = "Error: \"%s\" not registered.  Enter \"help\" to view a list of available commands.\r\n\r\n";
 
 
@@ -234,23 +499,21 @@ void lwcli_software_init(void)
     if (lwcliObj.opt == NULL) {
         return;  /* 需先调用 lwcli_hardware_init(opt) */
     }
-    /** 初始化命令链表头节点 */
-    lwcliObj.command = (command_t *)lwcli_opt_malloc(sizeof(command_t));
-    if (lwcliObj.command == NULL) {
-        lwcli_printf("lwcli malloc error\r\n");
-        return;
-    }
-    list_head_init(&lwcliObj.command->node);
-#if (LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE)
-    list_head_init(&lwcliObj.command->para.node);
-#endif  // LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE
-    int command_fd = 0;
-    command_fd = lwcli_regist_command("help", "list all commands", lwcli_help);
-#if (LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE)
-    lwcliObj.help_fd = command_fd;
-#endif  // LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE
+    lwcliObj.initialized = true;
+#if (LWCLI_USING_MODULE == LWCLI_TRUE)
+    lwcliObj.module_attached = 0xFFFFFFFFu;     /* 模块默认挂载 */
+    lwcliObj.module_current = LWCLI_MODULE_DEFAULT;
+#endif  // LWCLI_USING_MODULE == LWCLI_TRUE
+    lwcli_regist_command("help", "list all commands", lwcli_help);
     lwcli_regist_command("clear", "clear screen", lwcli_clear);
 
+#if (LWCLI_USING_COMMAND_EXPORT == LWCLI_TRUE)
+    /** 注册链接到 lwcli_command 段的静态命令 */
+    if (LWCLI_EXPORT_SECTION_END > LWCLI_EXPORT_SECTION_START) {
+        lwcli_regist_command_table(LWCLI_EXPORT_SECTION_START, (uint16_t)(LWCLI_EXPORT_SECTION_END - LWCLI_EXPORT_SECTION_START));
+    }
+#endif  // LWCLI_USING_COMMAND_EXPORT == LWCLI_TRUE
+
     /** 初始化历史记录缓冲区 */
     #if (LWCLI_HISTORY_COMMAND_NUM > 0)
     lwcliObj.historyList.commandStrSize = LWCLI_RECEIVE_BUFFER_SIZE;
@@ -263,6 +526,7 @@ void lwcli_software_init(void)
     memset(lwcliObj.historyList.buffer, 0, LWCLI_HISTORY_COMMAND_NUM * LWCLI_RECEIVE_BUFFER_SIZE);
     #endif  // LWCLI_HISTORY_COMMAND_NUM > 0
 
+    lwcli_output_hold();
     lwcli_printf("%s\r\n"," ___                        ___           ");
     lwcli_printf("%s\r\n","/\\_ \\                      /\\_ \\    __    ");
     lwcli_printf("%s\r\n","\\//\\ \\    __  __  __    ___\\//\\ \\  /\\_\\   ");
@@ -272,11 +536,48 @@ void lwcli_software_init(void)
     lwcli_printf("%s\r\n","   \\/____/ \\/__//__/   \\/____/\\/____/ \\/_/");
     lwcli_printf("lwcli version: "LWCLI_VERSION" Enter \"help\" to learn more infomation""\r\n");
     lwcli_printf("%s\r\n","                                          ");
+#if (LWCLI_BRACKETED_PASTE == LWCLI_TRUE)
+    lwcli_printf(ansi_paste_enable);
+#endif  // LWCLI_BRACKETED_PASTE == LWCLI_TRUE
 
 #if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
     lwcli_output_file_path();
 #endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
+    lwcli_output_release();
+}
+
+#if (LWCLI_WRITE_COMBINE == LWCLI_TRUE)
+/**
+ * @brief 立即输出合并缓冲区中的内容
+ */
+void lwcli_flush(void)
+{
+    if (lwcliObj.writeLen == 0) {
+        return;
+    }
+#if (LWCLI_ASYNC_OUTPUT == LWCLI_TRUE)
+    while (lwcliObj.outputBusy) {
+        LWCLI_OUTPUT_WAIT();  // 等待上一块发送完成
+    }
+    lwcliObj.outputBusy = 1;
+    lwcliObj.opt->output(lwcliObj.writeBuffer[lwcliObj.writeIndex], lwcliObj.writeLen);
+    lwcliObj.writeIndex ^= 1;
+#else
+    lwcliObj.opt->output(lwcliObj.writeBuffer, lwcliObj.writeLen);
+#endif  // LWCLI_ASYNC_OUTPUT == LWCLI_TRUE
+    lwcliObj.writeLen = 0;
+}
+#endif  // LWCLI_WRITE_COMBINE == LWCLI_TRUE
+
+#if (LWCLI_ASYNC_OUTPUT == LWCLI_TRUE)
+/**
+ * @brief 通知 lwcli 上一次 output 交出的缓冲区已发送完成
+ */
+void lwcli_output_done(void)
+{
+    lwcliObj.outputBusy = 0;
 }
+#endif  // LWCLI_ASYNC_OUTPUT == LWCLI_TRUE
 
 /**
  * @brief 注册命令
@@ -298,417 +599,2665 @@ int lwcli_regist_command(const char *command, const char *brief, user_callback_f
         lwcli_printf("help string too long please modify LWCLI_BRIEF_MAX_LENGTH \r\n");
         return -1;
     }
-    if (lwcliObj.command == NULL) {
+    if (!lwcliObj.initialized) {
         lwcli_printf("please call lwcli_software_init before regist command \r\n");
         return -1;
     }
+#if (LWCLI_REGIST_ZERO_COPY == LWCLI_TRUE)
     command_t *new_cmd = (command_t *)lwcli_opt_malloc(sizeof(command_t));
     if (new_cmd == NULL) {
         lwcli_printf("lwcli malloc error\r\n");
         return -1;
     }
-    new_cmd->cmd_len = strlen(command);
-    memcpy(new_cmd->command, command, new_cmd->cmd_len);
-    new_cmd->command[new_cmd->cmd_len] = '\0';
-    memcpy(new_cmd->brief, brief, strlen(brief));
-    new_cmd->brief[strlen(brief)] = '\0';
-    new_cmd->callback = user_callback;
+    new_cmd->desc.command = command;
+    new_cmd->desc.brief = brief;
+#else
+    size_t command_size = strlen(command) + 1;
+    size_t brief_size = strlen(brief) + 1;
+    command_t *new_cmd = (command_t *)lwcli_opt_malloc(sizeof(command_t) + command_size + brief_size);
+    if (new_cmd == NULL) {
+        lwcli_printf("lwcli malloc error\r\n");
+        return -1;
+    }
+    char *str = (char *)(new_cmd + 1);
+    memcpy(str, command, command_size);
+    memcpy(str + command_size, brief, brief_size);
+    new_cmd->desc.command = str;
+    new_cmd->desc.brief = str + command_size;
+#endif  // LWCLI_REGIST_ZERO_COPY == LWCLI_TRUE
+    new_cmd->desc.callback = user_callback;
+    new_cmd->desc.parameters = NULL;
+    new_cmd->desc.parameter_num = 0;
+    new_cmd->parameter_cap = 0;
+    uint16_t sorted_from = lwcliObj.command_num;
+    int command_fd = lwcli_command_insert(&new_cmd->desc, LWCLI_COMMAND_FLAG_DYNAMIC);
+    lwcli_command_sort_insert(sorted_from);
+    if (command_fd < 0) {
+        lwcli_opt_free(new_cmd);
+        return -1;
+    }
+    return command_fd;
+}
+
+/**
+ * @brief 注册静态命令表
+ * @param table 命令描述符数组
+ * @param num 数组元素个数
+ * @return 成功注册的命令个数
+ */
+int lwcli_regist_command_table(const lwcli_command_t *table, uint16_t num)
+{
+    lwcli_assert_return(table != NULL, -1);
+    if (!lwcliObj.initialized) {
+        lwcli_printf("please call lwcli_software_init before regist command \r\n");
+        return -1;
+    }
+    int regist_num = 0;
+    for (uint16_t i = 0; i < num; i++) {
+        if (table[i].command == NULL || table[i].brief == NULL || table[i].callback == NULL) {
+            continue;
+        }
 #if (LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE)
-    list_head_init(&new_cmd->para.node);
+        /* 参数补全依赖有序参数表 */
+        uint16_t j = 1;
+        while (j < table[i].parameter_num &&
+               lwcli_parameter_compare(&table[i].parameters[j - 1], table[i].parameters[j].position, table[i].parameters[j].parameter, LWCLI_COMPARE_WHOLE) <= 0) {
+            j++;
+        }
+        if (j < table[i].parameter_num) {
+            lwcli_printf("parameter table of \"%s\" must be sorted by position and string\r\n", table[i].command);
+            continue;
+        }
 #endif  // LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE
-    list_node_init(&new_cmd->node);
-    list_add_tail(&lwcliObj.command->node, &new_cmd->node);
-    lwcliObj.command_num++;
-    #if (LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE)
-    if (lwcliObj.help_fd) {
-        char buffer[LWCLI_COMMAND_STR_MAX_LENGTH + 30] = {0};
-        snprintf(buffer, sizeof(buffer), "get the detail of [%s]", command);
-        lwcli_regist_command_parameter(lwcliObj.help_fd, command, buffer);
+        if (lwcli_command_insert(&table[i], 0) > 0) {
+            regist_num++;
+        }
     }
-    #endif  // LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE
-    return lwcliObj.command_num;
+    lwcli_command_sort();    /* 整表注册后只排序一次 */
+    return regist_num;
 }
 
-#if (LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE)
 /**
- * @brief 注册命令参数 用于help 和 tab补全
- * @param command_fd 命令描述符 @brief lwcli_regist_command
- * @param parameter 参数 
- * @param description 详细的说明 可以为NULL
+ * @brief 计算命令树节点名（最后一个 token）在完整命令路径中的偏移
+ * @param hot 节点
+ * @return 偏移
  */
-void lwcli_regist_command_parameter(int command_fd, const char *parameter, const char *description)
+static inline uint16_t lwcli_command_name_offset(const command_hot_t *hot)
 {
-    lwcli_assert(command_fd > 0);
-    lwcli_assert(command_fd <= lwcliObj.command_num);
-    lwcli_assert(parameter);
-    command_t *cmd = NULL;
-    parameter_t *new_param = NULL;
-    int i = 0;
+    return hot->parent ? lwcliObj.command_hot[hot->parent - 1].cmd_len + 1 : 0;
+}
+
+/**
+ * @brief 命令是否可见（所属模块已挂载）
+ * @param hot 命令
+ * @return true 可见
+ */
+static inline bool lwcli_command_visible(const command_hot_t *hot)
+{
+#if (LWCLI_USING_MODULE == LWCLI_TRUE)
+    return (lwcliObj.module_attached >> hot->module) & 1u;
+#else
+    (void)hot;
+    return true;
+#endif  // LWCLI_USING_MODULE == LWCLI_TRUE
+}
 
-    list_for_each_entry(cmd, &lwcliObj.command->node, node, command_t) {
-        i++;
-        if (i == command_fd) break;
+/**
+ * @brief 把槽位插入双向链表头部
+ * @param links 链接数组
+ * @param head 链表头（下标 + 1）
+ * @param index 热数据下标
+ */
+static void lwcli_link_insert(command_link_t *links, uint16_t *head, uint16_t index)
+{
+    links[index].prev = 0;
+    links[index].next = *head;
+    if (*head != 0) {
+        links[*head - 1].prev = index + 1;
     }
-    if (i != command_fd) return;
+    *head = index + 1;
+}
 
-    new_param = (parameter_t *)lwcli_opt_malloc(sizeof(parameter_t));
-    if (new_param == NULL) {
-        lwcli_printf("%s %d ,malloc error ", __FILE__, __LINE__);
-        return;
+/**
+ * @brief 从双向链表中摘除槽位
+ * @param links 链接数组
+ * @param head 链表头（下标 + 1）
+ * @param index 热数据下标
+ */
+static void lwcli_link_remove(command_link_t *links, uint16_t *head, uint16_t index)
+{
+    uint16_t next = links[index].next;
+    uint16_t prev = links[index].prev;
+    if (prev != 0) {
+        links[prev - 1].next = next;
+    } else {
+        *head = next;
     }
-    uint32_t param_data_len = strlen(parameter) + 1;
-    new_param->data = lwcli_parameter_malloc(param_data_len);
-    if (new_param->data == NULL) {
-        lwcli_printf("%s %d ,malloc error ", __FILE__, __LINE__);
-        lwcli_opt_free(new_param);
-        return;
+    if (next != 0) {
+        links[next - 1].prev = prev;
     }
-    if (description) {
-        new_param->description = (char *)lwcli_opt_malloc(strlen(description) + 1);
-        if (new_param->description == NULL) {
-            lwcli_printf("%s %d ,malloc error ", __FILE__, __LINE__);
-            parameter_pool.pos -= param_data_len;  /* 回滚 parameter 池 */
-            lwcli_opt_free(new_param);
-            return;
+}
+
+/**
+ * @brief 取得节点的子节点链表头
+ * @param parent 热数据下标 + 1，0 为根
+ * @return 链表头
+ */
+static inline uint16_t *lwcli_command_children(uint16_t parent)
+{
+    return parent ? &lwcliObj.command_child[parent - 1] : &lwcliObj.command_root;
+}
+
+/**
+ * @brief 新建命令树节点并插入哈希索引和有序索引
+ * @param parent 父节点热数据下标 + 1，0 为根
+ * @param hash (parent, token) 哈希
+ * @param desc 命令描述符
+ * @param cmd_len 完整命令路径长度
+ * @param flags LWCLI_COMMAND_FLAG_xxx
+ * @return 节点热数据下标 + 1
+ */
+static uint16_t lwcli_command_node_new(uint16_t parent, uint32_t hash, const lwcli_command_t *desc, uint16_t cmd_len, uint8_t flags)
+{
+    /* 优先复用已注销命令的槽位 */
+    uint16_t index = lwcliObj.command_used;
+    if (lwcliObj.command_free != 0) {
+        index = lwcliObj.command_free - 1;
+        lwcliObj.command_free = lwcliObj.command_hot[index].parent;
+        lwcliObj.command_free_num--;
+    } else {
+        lwcliObj.command_used++;
+    }
+    command_hot_t *hot = &lwcliObj.command_hot[index];
+    hot->hash = hash;
+    hot->callback = (flags & LWCLI_COMMAND_FLAG_GROUP) ? NULL : desc->callback;
+    hot->desc = desc;
+    hot->parent = parent;
+    hot->cmd_len = cmd_len;
+    hot->flags = flags;
+#if (LWCLI_USING_MODULE == LWCLI_TRUE)
+    hot->module = lwcliObj.module_current;
+#endif  // LWCLI_USING_MODULE == LWCLI_TRUE
+    uint16_t slot = hash & (LWCLI_COMMAND_HASH_SIZE - 1);
+    while (lwcliObj.command_index[slot] != 0) {
+        slot = (slot + 1) & (LWCLI_COMMAND_HASH_SIZE - 1);
+    }
+    lwcliObj.command_index[slot] = index + 1;
+    lwcliObj.command_child[index] = 0;
+    lwcli_link_insert(lwcliObj.command_sibling, lwcli_command_children(parent), index);
+#if (LWCLI_USING_MODULE == LWCLI_TRUE)
+    if (!(flags & LWCLI_COMMAND_FLAG_GROUP)) {
+        lwcli_link_insert(lwcliObj.command_module, &lwcliObj.module_head[hot->module], index);
+    }
+#endif  // LWCLI_USING_MODULE == LWCLI_TRUE
+
+    /* 有序索引先追加，由注册函数在返回前排入有序位置 */
+    lwcliObj.command_sorted[lwcliObj.command_num++] = index;
+    lwcliObj.line.dirty = true;     /* 已解析的命令路径可能变化 */
+    return index + 1;
+}
+
+/**
+ * @brief 将命令描述符插入命令树
+ * @note 命令字符串按空格拆分为 token 逐级插入，不存在的上级节点自动创建为中间节点；
+ *       之后注册同名上级命令时，中间节点直接升级为普通命令
+ * @param desc 命令描述符，注册后须一直有效
+ * @param flags LWCLI_COMMAND_FLAG_xxx
+ * @return 命令描述符 command_fd，失败返回 -1
+ */
+static int lwcli_command_insert(const lwcli_command_t *desc, uint8_t flags)
+{
+    const char *str = desc->command;
+    uint16_t len = 0, new_num = 0;
+    uint16_t parent = 0;
+
+    /* 校验：token 以单个空格分隔，首尾无空格；同时统计需要新建的节点数 */
+    while (str[len] != '\0' && len < LWCLI_COMMAND_STR_MAX_LENGTH) {
+        if (str[len] == ' ' && (len == 0 || str[len - 1] == ' ' || str[len + 1] == '\0')) {
+            break;
+        }
+        len++;
+    }
+    if (len == 0 || str[len] != '\0') {
+        lwcli_printf("command \"%s\" invalid\r\n", str);
+        return -1;
+    }
+    for (uint16_t start = 0, pos = 0; pos <= len; pos++) {
+        if (pos < len && str[pos] != ' ') {
+            continue;
         }
+        command_hot_t *node = (new_num == 0) ? lwcli_find_node(parent, str + start, pos - start) : NULL;
+        if (node == NULL) {
+            new_num++;
+        } else if (pos == len && !(node->flags & LWCLI_COMMAND_FLAG_GROUP)) {
+            lwcli_printf("command \"%s\" already registered\r\n", str);
+            return -1;
+        } else {
+            parent = (uint16_t)(node - lwcliObj.command_hot) + 1;
+        }
+        start = pos + 1;
+    }
+    if (new_num > LWCLI_COMMAND_MAX_NUM - lwcliObj.command_num) {
+        lwcli_printf("command table full please modify LWCLI_COMMAND_MAX_NUM \r\n");
+        return -1;
     }
 
-    new_param->len = strlen(parameter);
-    strcpy(new_param->data, parameter);
-    if (description) {
-        strcpy(new_param->description, description);
+    /* 逐级插入 */
+    parent = 0;
+    for (uint16_t start = 0, pos = 0; pos <= len; pos++) {
+        if (pos < len && str[pos] != ' ') {
+            continue;
+        }
+        uint32_t hash = LWCLI_HASH_SEED(parent);
+        for (uint16_t i = start; i < pos; i++) {
+            hash = LWCLI_HASH_STEP(hash, LWCLI_CASE_FOLD(str[i]));
+        }
+        command_hot_t *node = lwcli_find_node(parent, str + start, pos - start);
+        if (pos == len) {
+            if (node != NULL) {    /* 中间节点升级为普通命令 */
+                uint16_t index = (uint16_t)(node - lwcliObj.command_hot);
+                const lwcli_command_t *borrowed = node->desc;
+                node->callback = desc->callback;
+                node->desc = desc;
+                node->flags = flags;
+                /* 与它借用同一描述符的上级节点改借本命令，保持同一描述符只被一段连续的祖先链借用 */
+                for (uint16_t up = node->parent; up != 0 && lwcliObj.command_hot[up - 1].desc == borrowed; up = lwcliObj.command_hot[up - 1].parent) {
+                    lwcliObj.command_hot[up - 1].desc = desc;
+                }
+#if (LWCLI_USING_MODULE == LWCLI_TRUE)
+                node->module = lwcliObj.module_current;
+                lwcli_link_insert(lwcliObj.command_module, &lwcliObj.module_head[node->module], index);
+#endif  // LWCLI_USING_MODULE == LWCLI_TRUE
+                return (int)index + 1;
+            }
+            return lwcli_command_node_new(parent, hash, desc, len, flags);
+        }
+#if (LWCLI_USING_MODULE == LWCLI_TRUE)
+        if (node != NULL && (node->flags & LWCLI_COMMAND_FLAG_GROUP) && node->module != lwcliObj.module_current) {
+            node->module = LWCLI_MODULE_DEFAULT;   /* 多个模块共用的中间节点归入默认模块 */
+        }
+#endif  // LWCLI_USING_MODULE == LWCLI_TRUE
+        parent = (node != NULL) ? (uint16_t)(node - lwcliObj.command_hot) + 1
+                                : lwcli_command_node_new(parent, hash, desc, pos, LWCLI_COMMAND_FLAG_GROUP);
+        start = pos + 1;
     }
-    list_node_init(&new_param->node);
-    list_add_tail(&cmd->para.node, &new_param->node);
+    return -1;
 }
 
 /**
- * @brief 从参数注册内存池分配（用于 lwcli_regist_command_parameter）
- * @param size 字符串长度
- * @return 指针，失败返回 NULL
+ * @brief 注销命令
+ * @param command_fd 命令描述符
  */
-static char *lwcli_parameter_malloc(uint32_t size)
+void lwcli_unregist_command(int command_fd)
 {
-    return LWCLI_POOL_ALLOC(parameter, size);
+    lwcli_assert(command_fd > 0);
+    lwcli_assert(command_fd <= lwcliObj.command_used);
+    command_hot_t *hot = &lwcliObj.command_hot[command_fd - 1];
+    lwcli_assert(!(hot->flags & (LWCLI_COMMAND_FLAG_FREE | LWCLI_COMMAND_FLAG_GROUP)));
+    lwcli_command_remove((uint16_t)(command_fd - 1));
+    lwcli_command_compact();
 }
-#endif  // LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE
 
+#if (LWCLI_USING_MODULE == LWCLI_TRUE)
 /**
- * @brief 从 dynamic 内存池分配（用于 Tab 补全、参数分割等运行时临时分配）
- * @param size 分配长度
- * @return 指针，失败返回 NULL
+ * @brief 选择之后注册的命令所属的模块
+ * @param module 模块编号
  */
-static char *lwcli_dynamic_malloc(uint32_t size)
+void lwcli_module_select(uint8_t module)
 {
-    return LWCLI_POOL_ALLOC(dynamic, size);
+    lwcli_assert(module < LWCLI_MODULE_MAX_NUM);
+    lwcliObj.module_current = module;
 }
 
 /**
- * @brief 释放 dynamic 内存池（使用完毕后调用，重置池供下次使用）
+ * @brief 挂载模块
+ * @param module 模块编号
  */
-static void lwcli_dynamic_free(void)
+void lwcli_module_attach(uint8_t module)
 {
-    dynamic_pool.pos = 0;
+    lwcli_assert(module < LWCLI_MODULE_MAX_NUM);
+    lwcliObj.module_attached |= 1u << module;
+    lwcliObj.line.dirty = true;
 }
 
 /**
- * @brief 帮助命令
+ * @brief 卸载模块，只清除位图，不释放内存
+ * @param module 模块编号
  */
-#if (LWCLI_PARAMETER_SPLIT == LWCLI_TRUE)
-static void lwcli_help(int argc, char *argv[])
+void lwcli_module_detach(uint8_t module)
 {
-    command_t *cmd = NULL;
-    uint16_t output_len = 0;
-    memset(lwcliObj.ouputBuffer, 0, sizeof(lwcliObj.ouputBuffer));
-    if (argc == 0) {
-        list_for_each_entry(cmd, &lwcliObj.command->node, node, command_t) {
-            if (cmd->brief[0] != '\0') {
-                memcpy(lwcliObj.ouputBuffer, cmd->command, cmd->cmd_len);
-                output_len = cmd->cmd_len;
-                lwcliObj.ouputBuffer[output_len++] = ':';
-                for (uint16_t i = 0; i < (LWCLI_COMMAND_STR_MAX_LENGTH + 3 - (cmd->cmd_len + 1) + 4); i++) {
-                    lwcliObj.ouputBuffer[output_len++] = ' ';
-                }
-                uint16_t helpStrLen = strlen(cmd->brief);
-                memcpy(lwcliObj.ouputBuffer + output_len, cmd->brief, helpStrLen);
-                output_len += helpStrLen;
-                lwcliObj.ouputBuffer[output_len++] = '\r';
-                lwcliObj.ouputBuffer[output_len++] = '\n';
-                lwcliObj.ouputBuffer[output_len++] = '\r';
-                lwcliObj.ouputBuffer[output_len++] = '\n';
-                lwcliObj.ouputBuffer[output_len++] = '\0';
-                lwcli_opt_output(lwcliObj.ouputBuffer, output_len);
-            }
+    lwcli_assert(module < LWCLI_MODULE_MAX_NUM);
+    lwcli_assert(module != LWCLI_MODULE_DEFAULT);
+    lwcliObj.module_attached &= ~(1u << module);
+    lwcliObj.line.dirty = true;
+}
+
+/**
+ * @brief 注销模块中的全部命令并释放内存
+ * @param module 模块编号
+ */
+void lwcli_module_release(uint8_t module)
+{
+    lwcli_assert(module < LWCLI_MODULE_MAX_NUM);
+    lwcli_assert(module != LWCLI_MODULE_DEFAULT);
+    while (lwcliObj.module_head[module] != 0) {
+        lwcli_command_remove(lwcliObj.module_head[module] - 1);
+    }
+    lwcli_command_compact();
+}
+#endif  // LWCLI_USING_MODULE == LWCLI_TRUE
+
+/**
+ * @brief 从哈希索引中删除节点
+ * @note 线性探测的后移删除：把探测链上可以前移的元素依次填入空洞，不留墓碑，无需重建索引
+ * @param index 热数据下标
+ */
+static void lwcli_command_index_remove(uint16_t index)
+{
+    const uint16_t mask = LWCLI_COMMAND_HASH_SIZE - 1;
+    uint16_t hole = lwcliObj.command_hot[index].hash & mask;
+    while (lwcliObj.command_index[hole] != index + 1) {
+        hole = (hole + 1) & mask;
+    }
+    for (uint16_t slot = (hole + 1) & mask; lwcliObj.command_index[slot] != 0; slot = (slot + 1) & mask) {
+        uint16_t home = lwcliObj.command_hot[lwcliObj.command_index[slot] - 1].hash & mask;
+        if (((slot - home) & mask) >= ((slot - hole) & mask)) {    /* 起始槽位不在 (hole, slot] 内，可以前移 */
+            lwcliObj.command_index[hole] = lwcliObj.command_index[slot];
+            hole = slot;
         }
     }
-    else {
-        uint16_t command_len = strlen(argv[0]);
-        cmd = NULL;
-        int found = 0;
-        list_for_each_entry(cmd, &lwcliObj.command->node, node, command_t) {
-            if (command_len == cmd->cmd_len && memcmp(cmd->command, argv[0], command_len) == 0) {
-                found = 1;
-                break;
-            }
+    lwcliObj.command_index[hole] = 0;
+}
+
+/**
+ * @brief 回收没有子节点的节点：从哈希索引和命令树中摘除，放入空闲链表
+ * @note 有序索引中的下标由 lwcli_command_compact() 统一移除
+ * @param index 热数据下标
+ */
+static void lwcli_command_node_free(uint16_t index)
+{
+    command_hot_t *hot = &lwcliObj.command_hot[index];
+    lwcli_command_index_remove(index);
+    lwcli_link_remove(lwcliObj.command_sibling, lwcli_command_children(hot->parent), index);
+    hot->flags = LWCLI_COMMAND_FLAG_FREE;
+    hot->desc = NULL;
+    hot->parent = lwcliObj.command_free;
+    lwcliObj.command_free = index + 1;
+    lwcliObj.command_free_num++;
+}
+
+/**
+ * @brief 注销一条命令
+ * @note 1. 从模块链表摘除，节点暂时变为中间节点；
+ *       2. 没有子节点的中间节点逐级向上回收；
+ *       3. 仍借用其描述符的上级中间节点改借首个子节点的描述符；
+ *       4. 释放命令及其参数的内存。
+ *       只访问命令路径上的节点，耗时与命令深度成正比；其余命令的 command_fd 不变，
+ *       有序索引须随后调用 lwcli_command_compact() 压缩
+ * @param index 热数据下标
+ */
+static void lwcli_command_remove(uint16_t index)
+{
+    command_hot_t *hot = &lwcliObj.command_hot[index];
+    const lwcli_command_t *desc = hot->desc;
+    bool dynamic = (hot->flags & LWCLI_COMMAND_FLAG_DYNAMIC) != 0;
+#if (LWCLI_USING_MODULE == LWCLI_TRUE)
+    lwcli_link_remove(lwcliObj.command_module, &lwcliObj.module_head[hot->module], index);
+    hot->module = LWCLI_MODULE_DEFAULT;
+#endif  // LWCLI_USING_MODULE == LWCLI_TRUE
+    hot->flags = LWCLI_COMMAND_FLAG_GROUP;
+    hot->callback = NULL;
+    lwcliObj.line.dirty = true;
+
+    uint16_t node = index + 1;
+    while (node != 0 && (lwcliObj.command_hot[node - 1].flags & LWCLI_COMMAND_FLAG_GROUP) && lwcliObj.command_child[node - 1] == 0) {
+        uint16_t parent = lwcliObj.command_hot[node - 1].parent;
+        lwcli_command_node_free(node - 1);
+        node = parent;
+    }
+    /* 借用 desc 的只有其祖先链上连续的一段中间节点，首个子节点的描述符来自其自身子树 */
+    while (node != 0 && lwcliObj.command_hot[node - 1].desc == desc) {
+        lwcliObj.command_hot[node - 1].desc = lwcliObj.command_hot[lwcliObj.command_child[node - 1] - 1].desc;
+        node = lwcliObj.command_hot[node - 1].parent;
+    }
+
+    if (dynamic) {
+        command_t *cmd = (command_t *)desc;
+#if (LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE) && (LWCLI_REGIST_ZERO_COPY == LWCLI_FALSE)
+        for (uint16_t j = 0; j < cmd->desc.parameter_num; j++) {
+            lwcli_opt_free((void *)cmd->desc.parameters[j].parameter);   /* 说明与参数字符串一次分配 */
         }
-        if (!found || cmd == NULL) {
-            lwcli_printf("Error: \"%s\" not found. Enter \"help\" to view available commands.\r\n", argv[0]);
-            return;
+#endif  // LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE && LWCLI_REGIST_ZERO_COPY == LWCLI_FALSE
+        if (cmd->desc.parameters != NULL) {
+            lwcli_opt_free((void *)cmd->desc.parameters);
         }
-        lwcli_printf("%s  %s\r\n", cmd->command, cmd->brief);
-#if (LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE)
-        {
-            parameter_t *param = NULL;
-            list_for_each_entry(param, &cmd->para.node, node, parameter_t) {
-                if (param->description) {
-                    lwcli_printf("[%s]:   %s\r\n", param->data, param->description);
-                } else {
-                    lwcli_printf("[%s]:   no description\r\n", param->data);
-                }
-            }
+        lwcli_opt_free(cmd);
+    }
+}
+
+/**
+ * @brief 从有序索引中移除已回收的槽位，保持原有顺序
+ * @note 一次注销只压缩一次，只搬移 uint16_t 下标，不比较字符串
+ */
+static void lwcli_command_compact(void)
+{
+    uint16_t sorted_num = 0;
+    for (uint16_t i = 0; i < lwcliObj.command_num; i++) {
+        uint16_t index = lwcliObj.command_sorted[i];
+        if (!(lwcliObj.command_hot[index].flags & LWCLI_COMMAND_FLAG_FREE)) {
+            lwcliObj.command_sorted[sorted_num++] = index;
         }
-#endif  // LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE
     }
+    lwcliObj.command_num = sorted_num;
 }
-#else
-static void lwcli_help(char *argvs)
+
+#if (LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE)
+/**
+ * @brief 注册命令参数 用于help 和 tab补全
+ * @param command_fd 命令描述符 @brief lwcli_regist_command
+ * @param parameter 参数 
+ * @param description 详细的说明 可以为NULL
+ */
+void lwcli_regist_command_parameter(int command_fd, const char *parameter, const char *description)
 {
-    command_t *cmd = NULL;
-    uint16_t output_len = 0;
-    const char *search = argvs;
-    while (*search == ' ') search++;
+    lwcli_regist_command_parameter_at(command_fd, 0, parameter, description);
+}
 
-    memset(lwcliObj.ouputBuffer, 0, sizeof(lwcliObj.ouputBuffer));
-    if (*search == '\0') {
-        list_for_each_entry(cmd, &lwcliObj.command->node, node, command_t) {
-            if (cmd->brief[0] != '\0') {
-                memcpy(lwcliObj.ouputBuffer, cmd->command, cmd->cmd_len);
-                output_len = cmd->cmd_len;
-                lwcliObj.ouputBuffer[output_len++] = ':';
-                for (uint16_t i = 0; i < (LWCLI_COMMAND_STR_MAX_LENGTH + 3 - (cmd->cmd_len + 1) + 4); i++) {
-                    lwcliObj.ouputBuffer[output_len++] = ' ';
-                }
-                uint16_t helpStrLen = strlen(cmd->brief);
-                memcpy(lwcliObj.ouputBuffer + output_len, cmd->brief, helpStrLen);
-                output_len += helpStrLen;
-                lwcliObj.ouputBuffer[output_len++] = '\r';
-                lwcliObj.ouputBuffer[output_len++] = '\n';
-                lwcliObj.ouputBuffer[output_len++] = '\r';
-                lwcliObj.ouputBuffer[output_len++] = '\n';
-                lwcliObj.ouputBuffer[output_len++] = '\0';
-                lwcli_opt_output(lwcliObj.ouputBuffer, output_len);
-            }
-        }
-    } else {
-        const char *p = search;
-        while (*p && *p != ' ') p++;
-        uint16_t search_len = (uint16_t)(p - search);
-        int found = 0;
-        list_for_each_entry(cmd, &lwcliObj.command->node, node, command_t) {
-            if (search_len == cmd->cmd_len && memcmp(cmd->command, search, search_len) == 0) {
-                found = 1;
-                break;
-            }
+/**
+ * @brief 取得可以追加参数的动态命令
+ * @param command_fd 命令描述符
+ * @return 命令，静态命令返回 NULL
+ */
+static command_t *lwcli_parameter_owner(int command_fd)
+{
+    lwcli_assert_return(command_fd > 0, NULL);
+    lwcli_assert_return(command_fd <= lwcliObj.command_used, NULL);
+    command_hot_t *hot = &lwcliObj.command_hot[command_fd - 1];
+    lwcli_assert_return(!(hot->flags & (LWCLI_COMMAND_FLAG_FREE | LWCLI_COMMAND_FLAG_GROUP)), NULL);
+    if (!(hot->flags & LWCLI_COMMAND_FLAG_DYNAMIC)) {
+        lwcli_printf("static command \"%s\" parameters come from its table\r\n", hot->desc->command);
+        return NULL;
+    }
+    return (command_t *)hot->desc;  /* desc 为 command_t 第一个成员 */
+}
+
+/**
+ * @brief 保证参数数组至少能容纳 need 个参数
+ * @note 容量按 2 倍增长（且不小于 need），逐个注册 n 个参数时扩容复制的总量为 O(n)
+ * @param cmd 动态命令
+ * @param need 需要的容量
+ * @return 成功返回 true
+ */
+static bool lwcli_parameter_reserve(command_t *cmd, uint32_t need)
+{
+    if (need <= cmd->parameter_cap) {
+        return true;
+    }
+    if (need > UINT16_MAX) {
+        lwcli_printf("command \"%s\" has too many parameters\r\n", cmd->desc.command);
+        return false;
+    }
+    uint32_t new_cap = cmd->parameter_cap ? (uint32_t)cmd->parameter_cap * 2 : 4;
+    if (new_cap < need) {
+        new_cap = need;
+    }
+    if (new_cap > UINT16_MAX) {
+        new_cap = UINT16_MAX;
+    }
+    lwcli_parameter_t *new_array = (lwcli_parameter_t *)lwcli_opt_malloc(sizeof(lwcli_parameter_t) * new_cap);
+    if (new_array == NULL) {
+        lwcli_printf("%s %d ,malloc error ", __FILE__, __LINE__);
+        return false;
+    }
+    if (cmd->desc.parameters != NULL) {
+        memcpy(new_array, cmd->desc.parameters, sizeof(lwcli_parameter_t) * cmd->desc.parameter_num);
+        lwcli_opt_free((void *)cmd->desc.parameters);
+    }
+    cmd->desc.parameters = new_array;
+    cmd->parameter_cap = (uint16_t)new_cap;
+    return true;
+}
+
+/**
+ * @brief 填写一个参数项，LWCLI_REGIST_ZERO_COPY 关闭时拷贝参数字符串与说明
+ * @param param 输出：参数项
+ * @param position 参数位置
+ * @param parameter 参数
+ * @param description 详细的说明 可以为NULL
+ * @return 成功返回 true
+ */
+static bool lwcli_parameter_make(lwcli_parameter_t *param, uint8_t position, const char *parameter, const char *description)
+{
+#if (LWCLI_REGIST_ZERO_COPY == LWCLI_TRUE)
+    param->parameter = parameter;
+    param->description = description;
+#else
+    /* 参数字符串与说明一次分配，注销时一并释放 */
+    size_t param_data_len = strlen(parameter) + 1;
+    size_t desc_data_len = description ? strlen(description) + 1 : 0;
+    char *data = (char *)lwcli_opt_malloc(param_data_len + desc_data_len);
+    if (data == NULL) {
+        lwcli_printf("%s %d ,malloc error ", __FILE__, __LINE__);
+        return false;
+    }
+    memcpy(data, parameter, param_data_len);
+    param->parameter = data;
+    param->description = NULL;
+    if (description) {
+        memcpy(data + param_data_len, description, desc_data_len);
+        param->description = data + param_data_len;
+    }
+#endif  // LWCLI_REGIST_ZERO_COPY == LWCLI_TRUE
+    param->position = position;
+    return true;
+}
+
+/**
+ * @brief 注册只在指定参数位置补全的命令参数
+ * @note 参数数组按 (position, parameter) 升序插入，补全时二分查找；
+ *       乱序逐个注册时每次插入移动 O(n) 个参数，大量参数请使用 lwcli_regist_command_parameter_table()
+ * @param command_fd 命令描述符 @brief lwcli_regist_command
+ * @param position 参数位置，从 1 开始，0 表示任意位置
+ * @param parameter 参数
+ * @param description 详细的说明 可以为NULL
+ */
+void lwcli_regist_command_parameter_at(int command_fd, uint8_t position, const char *parameter, const char *description)
+{
+    lwcli_assert(parameter);
+    command_t *cmd = lwcli_parameter_owner(command_fd);
+    if (cmd == NULL || !lwcli_parameter_reserve(cmd, (uint32_t)cmd->desc.parameter_num + 1)) {
+        return;
+    }
+    lwcli_parameter_t item;
+    if (!lwcli_parameter_make(&item, position, parameter, description)) {
+        return;
+    }
+
+    /* 二分查找插入位置，保持参数数组有序；按序注册时插在末尾，不移动 */
+    lwcli_parameter_t *array = (lwcli_parameter_t *)cmd->desc.parameters;
+    uint16_t low = 0, high = cmd->desc.parameter_num;
+    while (low < high) {
+        uint16_t mid = (low + high) / 2;
+        if (lwcli_parameter_compare(&array[mid], position, item.parameter, LWCLI_COMPARE_WHOLE) <= 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    memmove(&array[low + 1], &array[low], sizeof(lwcli_parameter_t) * (cmd->desc.parameter_num - low));
+    array[low] = item;
+    cmd->desc.parameter_num++;
+}
+
+/**
+ * @brief 批量注册命令参数
+ * @note 参数表须按 (position, parameter) 升序排列（与静态命令表的要求相同），
+ *       与已有参数从尾部一次归并：已有 n 个、新增 m 个参数时为 O(n + m)
+ * @param command_fd 命令描述符 @brief lwcli_regist_command
+ * @param table 参数表
+ * @param num 参数个数
+ * @return 成功注册的参数个数，失败返回 -1（已有参数不变）
+ */
+int lwcli_regist_command_parameter_table(int command_fd, const lwcli_parameter_t *table, uint16_t num)
+{
+    lwcli_assert_return(table != NULL, -1);
+    command_t *cmd = lwcli_parameter_owner(command_fd);
+    if (cmd == NULL) {
+        return -1;
+    }
+    if (num == 0) {
+        return 0;
+    }
+    for (uint16_t i = 1; i < num; i++) {
+        if (lwcli_parameter_compare(&table[i - 1], table[i].position, table[i].parameter, LWCLI_COMPARE_WHOLE) > 0) {
+            lwcli_printf("parameter table of \"%s\" must be sorted by position and string\r\n", cmd->desc.command);
+            return -1;
+        }
+    }
+    if (!lwcli_parameter_reserve(cmd, (uint32_t)cmd->desc.parameter_num + num)) {
+        return -1;
+    }
+    const lwcli_parameter_t *batch = table;
+#if (LWCLI_REGIST_ZERO_COPY == LWCLI_FALSE)
+    /* 先拷贝全部字符串，分配失败时已有参数保持不变 */
+    lwcli_parameter_t *copies = (lwcli_parameter_t *)lwcli_opt_malloc(sizeof(lwcli_parameter_t) * num);
+    if (copies == NULL) {
+        lwcli_printf("%s %d ,malloc error ", __FILE__, __LINE__);
+        return -1;
+    }
+    for (uint16_t i = 0; i < num; i++) {
+        if (!lwcli_parameter_make(&copies[i], table[i].position, table[i].parameter, table[i].description)) {
+            while (i > 0) {
+                lwcli_opt_free((void *)copies[--i].parameter);
+            }
+            lwcli_opt_free(copies);
+            return -1;
+        }
+    }
+    batch = copies;
+#endif  // LWCLI_REGIST_ZERO_COPY == LWCLI_FALSE
+
+    /* 从尾部归并，相等时已有参数在前 */
+    lwcli_parameter_t *array = (lwcli_parameter_t *)cmd->desc.parameters;
+    uint16_t old_num = cmd->desc.parameter_num, new_num = num;
+    uint16_t pos = (uint16_t)(old_num + num);     /* 已由 lwcli_parameter_reserve() 限制在 UINT16_MAX 以内 */
+    while (new_num > 0) {
+        const lwcli_parameter_t *item = &batch[new_num - 1];
+        if (old_num > 0 && lwcli_parameter_compare(&array[old_num - 1], item->position, item->parameter, LWCLI_COMPARE_WHOLE) > 0) {
+            array[--pos] = array[--old_num];
+        } else {
+            array[--pos] = *item;
+            new_num--;
+        }
+    }
+    cmd->desc.parameter_num += num;
+#if (LWCLI_REGIST_ZERO_COPY == LWCLI_FALSE)
+    lwcli_opt_free(copies);
+#endif  // LWCLI_REGIST_ZERO_COPY == LWCLI_FALSE
+    return num;
+}
+#endif  // LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE
+
+#if (LWCLI_USING_HOTKEY == LWCLI_TRUE)
+/**
+ * @brief 绑定热键
+ * @param key 热键编码：LWCLI_HOTKEY_CTRL(c) 或 lwcli_hotkey_e
+ * @param callback 回调函数，NULL 表示解除绑定
+ * @return 成功返回 0，失败返回 -1
+ */
+int lwcli_regist_hotkey(uint8_t key, lwcli_hotkey_f callback)
+{
+    if (key == 0 || key >= LWCLI_HOTKEY_NUM) {
+        return -1;
+    }
+    if (key == '\b' || key == '\t' || key == '\n' || key == '\r' || key == '\033') {
+        return -1;  /* 行编辑使用的控制字符 */
+    }
+    lwcliObj.hotkey[key] = callback;
+    return 0;
+}
+#endif  // LWCLI_USING_HOTKEY == LWCLI_TRUE
+
+#if (LWCLI_USING_RAW_MODE == LWCLI_TRUE)
+/**
+ * @brief 进入原始数据模式
+ * @param consumer 数据接收回调
+ * @param length 最多接收的字节数，0 表示不限
+ * @param terminator 结束字节，LWCLI_RAW_NO_TERMINATOR 表示不使用
+ * @return 成功返回 0，失败返回 -1
+ */
+int lwcli_raw_begin(lwcli_raw_f consumer, size_t length, int terminator)
+{
+    lwcli_assert_return(consumer != NULL, -1);
+    lwcli_assert_return(terminator >= LWCLI_RAW_NO_TERMINATOR && terminator <= 0xFF, -1);
+    if (lwcliObj.rawConsumer != NULL) {
+        return -1;
+    }
+    lwcliObj.ansiState = LWCLI_ANSI_STATE_NONE;
+    lwcliObj.rawRemain = length;
+    lwcliObj.rawTerminator = (int16_t)terminator;
+    lwcliObj.rawConsumer = consumer;
+    return 0;
+}
+
+/**
+ * @brief 退出原始数据模式并重新显示提示符
+ */
+void lwcli_raw_end(void)
+{
+    if (lwcliObj.rawConsumer == NULL) {
+        return;
+    }
+    lwcliObj.rawConsumer = NULL;
+    lwcli_output_hold();
+    lwcli_input_redraw();
+    lwcli_output_release();
+}
+#endif  // LWCLI_USING_RAW_MODE == LWCLI_TRUE
+
+/**
+ * @brief 输出一行命令简介（"命令:    简介"）
+ * @param hot 命令
+ */
+static void lwcli_help_output_brief(const command_hot_t *hot)
+{
+    const char *brief = (hot->flags & LWCLI_COMMAND_FLAG_GROUP) ? "" : hot->desc->brief;
+    int pad = LWCLI_COMMAND_STR_MAX_LENGTH + 3 - (hot->cmd_len + 1) + 4;
+    lwcli_printf("%.*s:%*s%s\r\n\r\n", hot->cmd_len, hot->desc->command, pad, "", brief);
+}
+
+/**
+ * @brief 输出所有带回调的命令简介（不含自动创建的中间节点）
+ */
+static void lwcli_help_output_all(void)
+{
+    for (uint16_t index = 0; index < lwcliObj.command_used; index++) {
+        const command_hot_t *hot = &lwcliObj.command_hot[index];
+        if (hot->callback != NULL && lwcli_command_visible(hot) && hot->desc->brief[0] != '\0') {
+            lwcli_help_output_brief(hot);
+        }
+    }
+}
+
+/**
+ * @brief 输出命令详细帮助：简介、参数与子命令
+ * @param hot 命令
+ */
+static void lwcli_help_output_detail(const command_hot_t *hot)
+{
+    const lwcli_command_t *cmd = hot->desc;
+    if (hot->flags & LWCLI_COMMAND_FLAG_GROUP) {
+        lwcli_printf("%.*s\r\n", hot->cmd_len, cmd->command);
+    } else {
+        lwcli_printf("%s  %s\r\n", cmd->command, cmd->brief);
+#if (LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE)
+        for (uint16_t i = 0; i < cmd->parameter_num; i++) {
+            const lwcli_parameter_t *param = &cmd->parameters[i];
+            if (param->description) {
+                lwcli_printf("[%s]:   %s\r\n", param->parameter, param->description);
+            } else {
+                lwcli_printf("[%s]:   no description\r\n", param->parameter);
+            }
+        }
+#endif  // LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE
+    }
+    if (hot->callback == lwcli_help) {
+        /* help 的参数即命令树中的命令，由命令索引生成，不单独注册 */
+        uint16_t first = 0;
+        uint16_t num = lwcli_command_prefix_range(0, "", 0, &first);
+        for (uint16_t i = first; i < first + num; i++) {
+            const command_hot_t *root = &lwcliObj.command_hot[lwcliObj.command_sorted[i]];
+            if (lwcli_command_visible(root)) {
+                lwcli_printf("[%.*s]:   get the detail of [%.*s]\r\n", root->cmd_len, root->desc->command, root->cmd_len, root->desc->command);
+            }
+        }
+    }
+    lwcli_output_subcommands((uint16_t)(hot - lwcliObj.command_hot) + 1);
+}
+
+/**
+ * @brief 帮助命令
+ */
+#if (LWCLI_PARAMETER_SPLIT == LWCLI_TRUE)
+static void lwcli_help(int argc, char *argv[], const uint16_t argl[])
+{
+    if (argc == 0) {
+        lwcli_help_output_all();
+    }
+    else {
+        /* 参数逐个对应命令树的一级，如 "help system reboot" */
+        command_hot_t *hot = NULL;
+        for (int i = 0; i < argc; i++) {
+            uint16_t parent = (hot != NULL) ? (uint16_t)(hot - lwcliObj.command_hot) + 1 : 0;
+            hot = lwcli_resolve_child(parent, argv[i], argl[i]);
+            if (hot == NULL) {
+                lwcli_printf("Error: \"%s\" not found. Enter \"help\" to view available commands.\r\n", argv[i]);
+                return;
+            }
+        }
+        lwcli_help_output_detail(hot);
+    }
+}
+#else
+static void lwcli_help(char *argvs)
+{
+    const char *search = argvs;
+    while (*search == ' ') search++;
+
+    if (*search == '\0') {
+        lwcli_help_output_all();
+    } else {
+        uint16_t search_len = 0;
+        command_hot_t *hot = lwcli_find_command(search, &search_len, true);
+        if (hot == NULL) {
+            lwcli_printf("Error: \"%s\" not found. Enter \"help\" to view available commands.\r\n", search);
+            return;
+        }
+        lwcli_help_output_detail(hot);
+    }
+}
+#endif  // LWCLI_PARAMETER_SPLIT == LWCLI_TRUE
+
+/**
+ * @brief 输出某个节点的全部子命令
+ * @param parent 父节点热数据下标 + 1
+ */
+static void lwcli_output_subcommands(uint16_t parent)
+{
+    uint16_t first = 0;
+    uint16_t num = lwcli_command_prefix_range(parent, "", 0, &first);
+    if (lwcli_command_visible_range(&first, &num) == 0) {
+        return;
+    }
+    lwcli_printf("subcommands:\r\n");
+    for (uint16_t i = first; i < first + num; i++) {
+        const command_hot_t *hot = &lwcliObj.command_hot[lwcliObj.command_sorted[i]];
+        if (lwcli_command_visible(hot)) {
+            lwcli_help_output_brief(hot);
+        }
+    }
+}
+
+/**
+ * @brief 清屏命令
+ */
+#if (LWCLI_PARAMETER_SPLIT == LWCLI_TRUE)
+static void lwcli_clear(int argc, char *argv[], const uint16_t argl[])
+#else
+static void lwcli_clear(char *argvs)
+#endif  // LWCLI_PARAMETER_SPLIT == LWCLI_TRUE
+{
+    lwcli_output_ansi(ansi_clear_screen);
+    lwcli_printf(ansi_cursor_move_to, 0, 0);
+}
+
+
+/**
+ * @brief 格式化输出的分块缓冲区，攒满或格式化结束时交给输出
+ */
+typedef struct {
+    uint16_t len;
+    char buf[LWCLI_PRINTF_CHUNK_SIZE];
+} lwcli_print_chunk_t;
+
+/**
+ * @brief 输出分块缓冲区中的内容
+ * @param chunk 分块缓冲区
+ */
+static void lwcli_chunk_flush(lwcli_print_chunk_t *chunk)
+{
+    if (chunk->len > 0) {
+        lwcli_opt_output(chunk->buf, chunk->len);
+        chunk->len = 0;
+    }
+}
+
+/**
+ * @brief 写入字符串，放不下时先输出已有内容，不小于缓冲区的字符串直接输出
+ * @param chunk 分块缓冲区
+ * @param str 字符串
+ * @param len 长度
+ */
+static void lwcli_chunk_write(lwcli_print_chunk_t *chunk, const char *str, size_t len)
+{
+    if (len > sizeof(chunk->buf) - chunk->len) {
+        lwcli_chunk_flush(chunk);
+        while (len >= sizeof(chunk->buf)) {
+            uint16_t n = (len > UINT16_MAX) ? UINT16_MAX : (uint16_t)len;
+            lwcli_opt_output(str, n);
+            str += n;
+            len -= n;
+        }
+    }
+    memcpy(chunk->buf + chunk->len, str, len);
+    chunk->len += len;
+}
+
+/**
+ * @brief 写入 n 个相同字符（宽度填充）
+ * @param chunk 分块缓冲区
+ * @param c 字符
+ * @param n 个数
+ */
+static void lwcli_chunk_fill(lwcli_print_chunk_t *chunk, char c, int n)
+{
+    while (n-- > 0) {
+        if (chunk->len == sizeof(chunk->buf)) {
+            lwcli_chunk_flush(chunk);
+        }
+        chunk->buf[chunk->len++] = c;
+    }
+}
+
+/**
+ * @brief 把无符号整数转换为数字字符，从 end 向前写入
+ * @param end 缓冲区末尾
+ * @param value 数值
+ * @param base 进制（8、10、16）
+ * @param digits 数字字符表
+ * @return 第一个数字字符的地址
+ */
+static char *lwcli_format_digits(char *end, unsigned long value, unsigned base, const char *digits)
+{
+    do {
+        *--end = digits[value % base];
+        value /= base;
+    } while (value != 0);
+    return end;
+}
+
+#if (LWCLI_PRINTF_EXTENDED == LWCLI_TRUE)
+/**
+ * @brief 同 lwcli_format_digits()，用于 ll 长度修饰，只有用到 %ll 时才进行 64 位除法
+ */
+static char *lwcli_format_digits_ll(char *end, unsigned long long value, unsigned base, const char *digits)
+{
+    do {
+        *--end = digits[value % base];
+        value /= base;
+    } while (value != 0);
+    return end;
+}
+#endif  // LWCLI_PRINTF_EXTENDED == LWCLI_TRUE
+
+/**
+ * @brief 流式格式化输出，不受缓冲区大小限制
+ * @note 支持的子集：转换 %d %i %u %o %x %X %c %s %p %%；标志 '-' '0' '+' ' '；宽度（数字或 *）；
+ *       %s 的精度（如 %.*s）；长度修饰 hh h l z。LWCLI_PRINTF_EXTENDED 另外支持 ll、整数精度与 '#'，
+ *       未启用时 ll 转换取走参数后原样输出，整数精度与 '#' 被忽略，不引入 64 位除法。
+ *       浮点转换（%f %e %g %a 等）取走 double 参数后原样输出，其他未知转换原样输出且不取参数；
+ *       格式串在转换说明中途结束时原样输出已读到的部分
+ * @param format 格式字符串
+ * @param args 参数
+ */
+void lwcli_vprintf(const char *format, va_list args)
+{
+    lwcli_print_chunk_t chunk;
+    const char *p = format;
+    chunk.len = 0;
+    while (*p != '\0') {
+        const char *start = p;
+        while (*p != '\0' && *p != '%') {
+            p++;
+        }
+        if (p > start) {
+            lwcli_chunk_write(&chunk, start, (size_t)(p - start));
+        }
+        if (*p == '\0') {
+            break;
+        }
+        const char *spec = p++;
+
+        bool left = false;
+#if (LWCLI_PRINTF_EXTENDED == LWCLI_TRUE)
+        bool alt = false;
+#endif  // LWCLI_PRINTF_EXTENDED == LWCLI_TRUE
+        char pad = ' ';
+        char plus = 0;      /* '+' 或 ' '：非负有符号数前的符号位 */
+        for (;; p++) {
+            if (*p == '-') {
+                left = true;
+            } else if (*p == '0') {
+                pad = '0';
+            } else if (*p == '+') {
+                plus = '+';
+            } else if (*p == ' ') {
+                if (plus == 0) {
+                    plus = ' ';
+                }
+            } else if (*p == '#') {
+#if (LWCLI_PRINTF_EXTENDED == LWCLI_TRUE)
+                alt = true;
+#endif  // LWCLI_PRINTF_EXTENDED == LWCLI_TRUE
+            } else {
+                break;
+            }
+        }
+        int width = 0;
+        if (*p == '*') {
+            width = va_arg(args, int);
+            if (width < 0) {
+                left = true;
+                width = -width;
+            }
+            p++;
+        } else {
+            while (*p >= '0' && *p <= '9') {
+                width = width * 10 + (*p++ - '0');
+            }
+        }
+        int precision = -1;
+        if (*p == '.') {
+            precision = 0;
+            if (*++p == '*') {
+                precision = va_arg(args, int);
+                if (precision < 0) {
+                    precision = -1;     /* 负的精度视为未指定 */
+                }
+                p++;
+            } else {
+                while (*p >= '0' && *p <= '9') {
+                    precision = precision * 10 + (*p++ - '0');
+                }
+            }
+        }
+        char size = 0;      /* 'H' 为 hh，'L' 为 ll */
+        if (*p == 'h') {
+            size = 'h';
+            if (*++p == 'h') {
+                size = 'H';
+                p++;
+            }
+        } else if (*p == 'l') {
+            size = 'l';
+            if (*++p == 'l') {
+                size = 'L';
+                p++;
+            }
+        } else if (*p == 'z') {
+            size = 'z';
+            p++;
+        }
+        if (*p == '\0') {
+            /* 格式串在转换说明中途结束：原样输出已读到的部分 */
+            lwcli_chunk_write(&chunk, spec, (size_t)(p - spec));
+            break;
+        }
+
+#if (LWCLI_PRINTF_EXTENDED == LWCLI_TRUE)
+        char num[sizeof(unsigned long long) * 3];   // 最长十进制/八进制位数
+#else
+        char num[sizeof(unsigned long) * 3];
+#endif  // LWCLI_PRINTF_EXTENDED == LWCLI_TRUE
+        const char *str = num;
+        size_t len = 0;
+        char sign = 0;
+        const char *prefix = "";
+        int zeros = 0;      /* 精度要求补的前导 0 */
+        switch (*p) {
+        case 's':
+            str = va_arg(args, const char *);
+            if (str == NULL) {
+                str = "(null)";
+            }
+            while (str[len] != '\0' && (precision < 0 || len < (size_t)precision)) {
+                len++;
+            }
+            pad = ' ';
+            break;
+        case 'c':
+            num[0] = (char)va_arg(args, int);
+            len = 1;
+            pad = ' ';
+            break;
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+        case 'p': {
+            unsigned long value = 0;
+#if (LWCLI_PRINTF_EXTENDED == LWCLI_TRUE)
+            unsigned long long value_ll = 0;
+#else
+            if (size == 'L' && *p != 'p') {
+                /* 未启用 LWCLI_PRINTF_EXTENDED：取走 ll 参数保持后续参数对齐，原样输出 */
+                (void)va_arg(args, long long);
+                str = spec;
+                len = (size_t)(p + 1 - spec);
+                width = 0;
+                break;
+            }
+#endif  // LWCLI_PRINTF_EXTENDED == LWCLI_TRUE
+            if (*p == 'p') {
+                value = (unsigned long)(uintptr_t)va_arg(args, void *);
+                prefix = "0x";
+            } else if (*p == 'd' || *p == 'i') {
+                bool negative;
+#if (LWCLI_PRINTF_EXTENDED == LWCLI_TRUE)
+                if (size == 'L') {
+                    long long v = va_arg(args, long long);
+                    negative = (v < 0);
+                    value_ll = negative ? 0ULL - (unsigned long long)v : (unsigned long long)v;
+                } else
+#endif  // LWCLI_PRINTF_EXTENDED == LWCLI_TRUE
+                {
+                    long v;
+                    if (size == 'l') {
+                        v = va_arg(args, long);
+                    } else if (size == 'z') {
+                        v = (long)va_arg(args, size_t);
+                    } else {
+                        v = va_arg(args, int);
+                        if (size == 'h') {
+                            v = (short)v;
+                        } else if (size == 'H') {
+                            v = (signed char)v;
+                        }
+                    }
+                    negative = (v < 0);
+                    value = negative ? 0UL - (unsigned long)v : (unsigned long)v;
+                }
+                sign = negative ? '-' : plus;
+            } else {
+#if (LWCLI_PRINTF_EXTENDED == LWCLI_TRUE)
+                if (size == 'L') {
+                    value_ll = va_arg(args, unsigned long long);
+                } else
+#endif  // LWCLI_PRINTF_EXTENDED == LWCLI_TRUE
+                if (size == 'l') {
+                    value = va_arg(args, unsigned long);
+                } else if (size == 'z') {
+                    value = va_arg(args, size_t);
+                } else {
+                    value = va_arg(args, unsigned int);
+                    if (size == 'h') {
+                        value = (unsigned short)value;
+                    } else if (size == 'H') {
+                        value = (unsigned char)value;
+                    }
+                }
+            }
+            unsigned base = (*p == 'o') ? 8 : (*p == 'x' || *p == 'X' || *p == 'p') ? 16 : 10;
+            const char *digits = (*p == 'X') ? "0123456789ABCDEF" : "0123456789abcdef";
+            char *end = num + sizeof(num);
+#if (LWCLI_PRINTF_EXTENDED == LWCLI_TRUE)
+            bool is_zero;
+            if (size == 'L' && *p != 'p') {
+                str = lwcli_format_digits_ll(end, value_ll, base, digits);
+                is_zero = (value_ll == 0);
+            } else {
+                str = lwcli_format_digits(end, value, base, digits);
+                is_zero = (value == 0);
+            }
+            len = (size_t)(end - str);
+            if (precision >= 0) {
+                pad = ' ';              /* 指定精度时忽略 '0' 标志 */
+                if (precision == 0 && is_zero) {
+                    len = 0;            /* 精度为 0 的 0 不输出数字 */
+                }
+            }
+            if (alt && !is_zero && (*p == 'x' || *p == 'X')) {
+                prefix = (*p == 'x') ? "0x" : "0X";
+            }
+            if (precision > 0 && (size_t)precision > len) {
+                zeros = precision - (int)len;
+            }
+            if (alt && *p == 'o' && zeros == 0 && (len == 0 || str[0] != '0')) {
+                zeros = 1;              /* %#o 保证首位为 0 */
+            }
+#else
+            str = lwcli_format_digits(end, value, base, digits);
+            len = (size_t)(end - str);
+#endif  // LWCLI_PRINTF_EXTENDED == LWCLI_TRUE
+            break;
+        }
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            /* 不支持浮点：取走参数保持后续参数对齐，原样输出 */
+            (void)va_arg(args, double);
+            str = spec;
+            len = (size_t)(p + 1 - spec);
+            width = 0;
+            break;
+        case '%':
+            num[0] = '%';
+            len = 1;
+            width = 0;
+            break;
+        default:
+            /* 不支持的转换，原样输出 */
+            str = spec;
+            len = (size_t)(p + 1 - spec);
+            width = 0;
+            break;
+        }
+        p++;
+
+        size_t prefix_len = strlen(prefix);
+        size_t used = len + (size_t)zeros + prefix_len + (sign != 0);
+        int fill = (used < (size_t)width) ? width - (int)used : 0;
+        if (!left && pad != '0') {
+            lwcli_chunk_fill(&chunk, ' ', fill);
+        }
+        lwcli_chunk_fill(&chunk, sign, sign != 0);
+        lwcli_chunk_write(&chunk, prefix, prefix_len);
+        if (!left && pad == '0') {
+            lwcli_chunk_fill(&chunk, '0', fill);
+        }
+        lwcli_chunk_fill(&chunk, '0', zeros);
+        lwcli_chunk_write(&chunk, str, len);
+        if (left) {
+            lwcli_chunk_fill(&chunk, ' ', fill);
+        }
+    }
+    lwcli_chunk_flush(&chunk);
+}
+
+/**
+ * @brief printf 函数
+ * @param format 格式字符串（见 lwcli_vprintf）
+ * @param ... 参数
+ */
+void lwcli_printf(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    lwcli_vprintf(format, args);
+    va_end(args);
+}
+
+/**
+ * @brief 输出字符串
+ * @param str 以 '\0' 结尾的字符串
+ */
+void lwcli_print(const char *str)
+{
+    size_t len = strlen(str);
+    while (len > UINT16_MAX) {
+        lwcli_opt_output(str, UINT16_MAX);
+        str += UINT16_MAX;
+        len -= UINT16_MAX;
+    }
+    lwcli_opt_output(str, (uint16_t)len);
+}
+
+/**
+ * @brief 输出指定长度的数据
+ * @param data 数据
+ * @param len 长度
+ */
+void lwcli_write(const char *data, uint16_t len)
+{
+    lwcli_opt_output(data, len);
+}
+
+/**
+ * @brief 光标之后的文本长度
+ * @note inputBuffer 为间隙缓冲区：光标前的文本位于缓冲区头部，光标后的文本紧贴缓冲区末尾
+ *       （最后一个字节固定为 '\0'），中间为间隙，插入、删除与光标移动均为 O(1)
+ */
+static inline uint16_t lwcli_input_tail_len(void)
+{
+    return lwcliObj.inputBufferPos - lwcliObj.cursorPos;
+}
+
+/**
+ * @brief 光标之后的文本起始地址
+ */
+static inline char *lwcli_input_tail(void)
+{
+    return lwcliObj.inputBuffer + sizeof(lwcliObj.inputBuffer) - 1 - lwcli_input_tail_len();
+}
+
+/**
+ * @brief 输出输入行 [from, to) 的内容（跨越间隙）
+ * @param from 起始下标
+ * @param to 结束下标
+ */
+static void lwcli_input_output(uint16_t from, uint16_t to)
+{
+    if (from < lwcliObj.cursorPos) {
+        uint16_t head_end = (to < lwcliObj.cursorPos) ? to : lwcliObj.cursorPos;
+        lwcli_opt_output(lwcliObj.inputBuffer + from, head_end - from);
+        from = head_end;
+    }
+    if (from < to) {
+        lwcli_opt_output(lwcli_input_tail() + from - lwcliObj.cursorPos, to - from);
+    }
+}
+
+/**
+ * @brief 合并间隙，使 inputBuffer[0, inputBufferPos) 为连续的以 '\0' 结尾的字符串
+ * @note 光标位置不变，处理整行（回车、Tab）前调用
+ */
+static void lwcli_input_gap_close(void)
+{
+    uint16_t tail_len = lwcli_input_tail_len();
+    if (tail_len > 0) {
+        memmove(lwcliObj.inputBuffer + lwcliObj.cursorPos, lwcli_input_tail(), tail_len);
+    }
+    lwcliObj.inputBuffer[lwcliObj.inputBufferPos] = '\0';
+}
+
+/**
+ * @brief 在光标处重新打开间隙，与 lwcli_input_gap_close() 配对使用
+ */
+static void lwcli_input_gap_open(void)
+{
+    uint16_t tail_len = lwcli_input_tail_len();
+    if (tail_len > 0) {
+        memmove(lwcli_input_tail(), lwcliObj.inputBuffer + lwcliObj.cursorPos, tail_len);
+    }
+    lwcliObj.inputBuffer[sizeof(lwcliObj.inputBuffer) - 1] = '\0';
+}
+
+/**
+ * @brief 以最少的字节把屏幕上的光标从输入行下标 from 移到 to
+ * @note 左移 4 个字符以内用退格（每字符 1 字节），否则用 ESC[nD；右移用 ESC[C / ESC[nC
+ * @param from 光标当前所在下标
+ * @param to 目标下标
+ */
+static void lwcli_screen_move(uint16_t from, uint16_t to)
+{
+    if (to < from) {
+        uint16_t n = from - to;
+        if (n < sizeof(lwcli_backspaces)) {
+            lwcli_opt_output(lwcli_backspaces, n);
+        }
+        else {
+            lwcli_printf(ansi_cursor_left_n, n);
+        }
+    }
+    else if (to > from) {
+        if (to - from == 1) {
+            lwcli_output_ansi(ansi_cursor_right);
+        }
+        else {
+            lwcli_printf(ansi_cursor_right_n, to - from);
+        }
+    }
+}
+
+/**
+ * @brief 按屏幕模型最小化重绘输入行
+ * @note 调用时输入行已是新内容，cursorPos 为新的光标位置；屏幕上仍是旧内容，且前 from 个字符与新内容相同。
+ *       只输出光标移动、from 之后的字符与行尾的清除，提示符与未变化的部分不重发
+ * @param screen_cursor 屏幕上光标所在下标
+ * @param screen_len 屏幕上输入内容的长度
+ * @param from 新旧内容第一个不同字符的下标
+ */
+static void lwcli_line_update(uint16_t screen_cursor, uint16_t screen_len, uint16_t from)
+{
+    uint16_t len = lwcliObj.inputBufferPos;
+    lwcli_screen_move(screen_cursor, from);
+    lwcli_input_output(from, len);
+    uint16_t end = len;
+    if (screen_len == len + 1) {
+        lwcli_opt_output(" ", 1);     /* 只多出一个字符时用空格覆盖，比 ESC[K 短 */
+        end++;
+    }
+    else if (screen_len > len) {
+        lwcli_output_ansi(ansi_clear_behind);
+    }
+    lwcli_screen_move(end, lwcliObj.cursorPos);
+}
+
+#if (LWCLI_HISTORY_COMMAND_NUM > 0)
+/**
+ * @brief 用 text 替换整个输入行，光标移到行尾，屏幕上只重绘变化的部分
+ * @param text 新内容（不能位于 inputBuffer 中）
+ * @param len 新内容长度
+ */
+static void lwcli_input_replace(const char *text, uint16_t len)
+{
+    uint16_t screen_cursor = lwcliObj.cursorPos;
+    uint16_t screen_len = lwcliObj.inputBufferPos;
+    lwcli_input_gap_close();
+    uint16_t from = 0;
+    while (from < len && from < screen_len && lwcliObj.inputBuffer[from] == text[from]) {
+        from++;
+    }
+    memcpy(lwcliObj.inputBuffer + from, text + from, len - from);
+    lwcliObj.inputBuffer[len] = '\0';
+    lwcliObj.inputBufferPos = len;
+    lwcliObj.cursorPos = len;
+    lwcliObj.line.dirty = true;
+    lwcli_line_update(screen_cursor, screen_len, from);
+}
+#endif  // LWCLI_HISTORY_COMMAND_NUM > 0
+
+/**
+ * @brief 光标左移
+ * @param n 移动的字符数，超出行首时移到行首
+ */
+static void lwcli_cursor_left(uint16_t n)
+{
+    if (n > lwcliObj.cursorPos) {
+        n = lwcliObj.cursorPos;
+    }
+    if (n == 0) {
+        return;
+    }
+    memmove(lwcli_input_tail() - n, lwcliObj.inputBuffer + lwcliObj.cursorPos - n, n);
+    lwcliObj.cursorPos -= n;
+    lwcli_screen_move(lwcliObj.cursorPos + n, lwcliObj.cursorPos);
+}
+
+/**
+ * @brief 光标右移
+ * @param n 移动的字符数，超出行尾时移到行尾
+ */
+static void lwcli_cursor_right(uint16_t n)
+{
+    if (n > lwcli_input_tail_len()) {
+        n = lwcli_input_tail_len();
+    }
+    if (n == 0) {
+        return;
+    }
+    memmove(lwcliObj.inputBuffer + lwcliObj.cursorPos, lwcli_input_tail(), n);
+    lwcliObj.cursorPos += n;
+    lwcli_screen_move(lwcliObj.cursorPos - n, lwcliObj.cursorPos);
+}
+
+static void lwcli_key_left(void)
+{
+    lwcli_cursor_left(1);
+}
+
+static void lwcli_key_right(void)
+{
+    lwcli_cursor_right(1);
+}
+
+static void lwcli_key_home(void)
+{
+    lwcli_cursor_left(lwcliObj.cursorPos);
+}
+
+static void lwcli_key_end(void)
+{
+    lwcli_cursor_right(lwcli_input_tail_len());
+}
+
+/**
+ * @brief 光标左移到上一个单词开头（Ctrl + ←）
+ */
+static void lwcli_key_word_left(void)
+{
+    uint16_t pos = lwcliObj.cursorPos;
+    while (pos > 0 && lwcliObj.inputBuffer[pos - 1] == ' ') pos--;
+    while (pos > 0 && lwcliObj.inputBuffer[pos - 1] != ' ') pos--;
+    lwcli_cursor_left(lwcliObj.cursorPos - pos);
+}
+
+/**
+ * @brief 光标右移到下一个单词结尾（Ctrl + →）
+ */
+static void lwcli_key_word_right(void)
+{
+    const char *tail = lwcli_input_tail();
+    uint16_t tail_len = lwcli_input_tail_len();
+    uint16_t n = lwcli_str_skip(tail, tail_len, ' ');
+    n += lwcli_str_find(tail + n, tail_len - n, ' ');
+    lwcli_cursor_right(n);
+}
+
+/**
+ * @brief 删除光标处的字符（Delete）
+ */
+static void lwcli_key_delete(void)
+{
+    if (lwcli_input_tail_len() == 0) {
+        return;
+    }
+    lwcliObj.inputBufferPos--;
+    lwcliObj.line.dirty = true;
+    lwcli_line_update(lwcliObj.cursorPos, lwcliObj.inputBufferPos + 1, lwcliObj.cursorPos);
+}
+
+#if (LWCLI_USING_HOTKEY == LWCLI_TRUE) || (LWCLI_USING_RAW_MODE == LWCLI_TRUE) || (LWCLI_BRACKETED_PASTE == LWCLI_TRUE)
+/**
+ * @brief 重绘整个输入行（提示符 + 输入内容），光标回到 cursorPos
+ */
+static void lwcli_input_redraw(void)
+{
+    lwcli_output_ansi(ansi_clear_line);
+#if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
+    lwcli_output_file_path();
+#endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
+    lwcli_input_output(0, lwcliObj.inputBufferPos);
+    lwcli_screen_move(lwcliObj.inputBufferPos, lwcliObj.cursorPos);
+#if (LWCLI_COMMAND_HIGHLIGHT == LWCLI_TRUE)
+    lwcliObj.highlightColor = LWCLI_HIGHLIGHT_NONE;  /* 重绘的内容未着色 */
+    lwcliObj.highlightLen = 0;
+#endif  // LWCLI_COMMAND_HIGHLIGHT == LWCLI_TRUE
+}
+#endif  // LWCLI_USING_HOTKEY || LWCLI_USING_RAW_MODE || LWCLI_BRACKETED_PASTE
+
+/**
+ * @brief 执行一条命令并记入历史
+ * @param command 以 '\0' 结尾的命令字符串
+ * @param len 命令长度
+ * @param line command 的解析状态，NULL 表示尚未解析（如粘贴队列中的命令）
+ */
+static void lwcli_command_execute(char *command, uint16_t len, const lwcli_line_t *line)
+{
+    lwcli_line_t parsed;
+    if (line == NULL) {
+        lwcli_line_reset(&parsed);
+        lwcli_line_parse(&parsed, command, 0, len);
+        line = &parsed;
+    }
+#if (LWCLI_HISTORY_COMMAND_NUM > 0)
+    if (len > 0) {
+        lwcli_add_history_command(command, len);
+    }
+#endif  // LWCLI_HISTORY_COMMAND_NUM > 0
+    lwcli_process_command(command, line);
+}
+
+#if (LWCLI_BRACKETED_PASTE == LWCLI_TRUE)
+#if (LWCLI_USING_RAW_MODE == LWCLI_TRUE)
+/**
+ * @brief 把粘贴的一行交给原始模式的 consumer
+ * @note 粘贴的命令进入原始模式后，其后粘贴的行是给它的数据，换行恢复为 '\n'；
+ *       原始模式在行中结束时，剩余部分仍按命令处理
+ * @param line 行内容，line[len] 须可写
+ * @param len 行长度
+ * @return 原始模式结束后剩余的字节数（不含换行），位于 line 末尾
+ */
+static uint16_t lwcli_paste_raw(char *line, uint16_t len)
+{
+    size_t used = 0;
+    line[len] = '\n';
+    while (used <= len && lwcli_raw_active()) {
+        used += lwcli_raw_input(line + used, (size_t)len + 1 - used);
+    }
+    line[len] = '\0';
+    return (used < len) ? (uint16_t)(len - used) : 0;
+}
+#endif  // LWCLI_USING_RAW_MODE == LWCLI_TRUE
+
+/**
+ * @brief 依次回显并执行粘贴队列中的命令
+ * @note 命令进入原始模式后，队列中剩余的行交给原始模式而不再作为命令执行
+ */
+static void lwcli_paste_flush(void)
+{
+    uint16_t pos = 0;
+    while (pos < lwcliObj.pasteQueueLen) {
+        char *command = lwcliObj.pasteQueue + pos;
+        uint16_t len = (uint16_t)strlen(command);
+        pos += len + 1;
+#if (LWCLI_USING_RAW_MODE == LWCLI_TRUE)
+        if (lwcli_raw_active()) {
+            uint16_t rest = lwcli_paste_raw(command, len);
+            command += len - rest;
+            len = rest;
+            if (len == 0) {
+                continue;
+            }
+        }
+#endif  // LWCLI_USING_RAW_MODE == LWCLI_TRUE
+        lwcli_output_ansi(ansi_clear_line);
+#if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
+        lwcli_output_file_path();
+#endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
+        lwcli_opt_output(command, len);
+        lwcli_opt_output("\r\n", 2);
+        lwcli_command_execute(command, len, NULL);
+    }
+    lwcliObj.pasteQueueLen = 0;
+}
+
+/**
+ * @brief 粘贴内容中的换行：当前行作为一条完整命令入队
+ */
+static void lwcli_paste_line_end(void)
+{
+    lwcli_input_gap_close();
+    uint16_t len = lwcliObj.inputBufferPos;
+    if (len > 0) {
+        if ((size_t)lwcliObj.pasteQueueLen + len + 1 > sizeof(lwcliObj.pasteQueue)) {
+            lwcli_paste_flush();
+        }
+#if (LWCLI_USING_RAW_MODE == LWCLI_TRUE)
+        if (lwcli_raw_active()) {   /* 队列中的命令进入了原始模式，本行是它的数据 */
+            uint16_t rest = lwcli_paste_raw(lwcliObj.inputBuffer, len);
+            memmove(lwcliObj.inputBuffer, lwcliObj.inputBuffer + len - rest, rest + 1);
+            len = rest;
+        }
+#endif  // LWCLI_USING_RAW_MODE == LWCLI_TRUE
+        if (len == 0) {
+            /* 本行已全部交给原始模式 */
+        }
+        else if ((size_t)len + 1 > sizeof(lwcliObj.pasteQueue)) {
+            /* 比队列还长的命令直接执行 */
+            lwcli_output_ansi(ansi_clear_line);
+#if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
+            lwcli_output_file_path();
+#endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
+            lwcli_opt_output(lwcliObj.inputBuffer, len);
+            lwcli_opt_output("\r\n", 2);
+            lwcli_command_execute(lwcliObj.inputBuffer, len, NULL);
+        }
+        else {
+            memcpy(lwcliObj.pasteQueue + lwcliObj.pasteQueueLen, lwcliObj.inputBuffer, len + 1);
+            lwcliObj.pasteQueueLen += len + 1;
+        }
+    }
+    lwcliObj.inputBuffer[0] = '\0';
+    lwcliObj.inputBufferPos = 0;
+    lwcliObj.cursorPos = 0;
+}
+
+/**
+ * @brief 处理粘贴内容中的一个字符（不回显）
+ * @param c 字符
+ */
+static void lwcli_paste_char(char c)
+{
+    if (c == '\r' || c == '\n') {
+        lwcli_paste_line_end();
+        return;
+    }
+    if (c == '\b' || c == ansi_delete) {
+        return;
+    }
+    if (lwcliObj.inputBufferPos >= sizeof(lwcliObj.inputBuffer) - 1) {
+        return;     /* 超长行截断 */
+    }
+    lwcliObj.inputBuffer[lwcliObj.cursorPos++] = (c == '\t') ? ' ' : c;
+    lwcliObj.inputBufferPos++;
+}
+
+static void lwcli_paste_begin(void)
+{
+    lwcliObj.pasting = true;
+    lwcliObj.line.dirty = true;
+}
+
+/**
+ * @brief 粘贴结束：执行排队的命令，剩余的未完成行重绘一次
+ */
+static void lwcli_paste_end(void)
+{
+    lwcliObj.pasting = false;
+    lwcli_paste_flush();
+    lwcli_input_redraw();
+}
+#endif  // LWCLI_BRACKETED_PASTE == LWCLI_TRUE
+
+#if (LWCLI_USING_HOTKEY == LWCLI_TRUE)
+/**
+ * @brief 执行热键回调：清除当前行，回调返回后重绘提示符与未完成的输入
+ * @param key 热键编码
+ */
+static void lwcli_hotkey_run(uint8_t key)
+{
+    lwcli_hotkey_f callback = lwcliObj.hotkey[key];
+    if (callback == NULL) {
+        return;
+    }
+    lwcli_output_ansi(ansi_clear_line);
+    lwcli_flush_before_callback();
+    callback(key);
+    lwcli_input_redraw();
+}
+#endif  // LWCLI_USING_HOTKEY == LWCLI_TRUE
+
+/**
+ * @brief 按键处理表，下标为 lwcli_key_e，NULL 表示忽略该按键
+ */
+static void (*const lwcli_key_handler[LWCLI_KEY_NUM])(void) = {
+#if (LWCLI_HISTORY_COMMAND_NUM > 0)
+    [LWCLI_KEY_UP]         = lwcli_history_command_up,
+    [LWCLI_KEY_DOWN]       = lwcli_history_command_down,
+#endif  // LWCLI_HISTORY_COMMAND_NUM > 0
+    [LWCLI_KEY_RIGHT]      = lwcli_key_right,
+    [LWCLI_KEY_LEFT]       = lwcli_key_left,
+    [LWCLI_KEY_HOME]       = lwcli_key_home,
+    [LWCLI_KEY_END]        = lwcli_key_end,
+    [LWCLI_KEY_DELETE]     = lwcli_key_delete,
+    [LWCLI_KEY_WORD_RIGHT] = lwcli_key_word_right,
+    [LWCLI_KEY_WORD_LEFT]  = lwcli_key_word_left,
+#if (LWCLI_BRACKETED_PASTE == LWCLI_TRUE)
+    [LWCLI_KEY_PASTE_BEGIN] = lwcli_paste_begin,
+    [LWCLI_KEY_PASTE_END]   = lwcli_paste_end,
+#endif  // LWCLI_BRACKETED_PASTE == LWCLI_TRUE
+};
+
+/**
+ * @brief 转义序列到按键的映射
+ * @note intro 为引导字符（CSI 为 '['，SS3 为 'O'）；final 为结束字符；code 为 ESC[n~ 中的 n（其他序列为 0）；
+ *       modifier 为第二个参数（ESC[1;5C 中的 5，无修饰键为 0）
+ */
+typedef struct
+{
+    char intro;
+    char final;
+    uint8_t code;
+    uint8_t modifier;
+    uint8_t key;
+}lwcli_ansi_key_t;
+
+static const lwcli_ansi_key_t lwcli_ansi_key_table[] = {
+    {'[', 'A', 0, 0, LWCLI_KEY_UP},
+    {'[', 'B', 0, 0, LWCLI_KEY_DOWN},
+    {'[', 'C', 0, 0, LWCLI_KEY_RIGHT},
+    {'[', 'D', 0, 0, LWCLI_KEY_LEFT},
+    {'[', 'H', 0, 0, LWCLI_KEY_HOME},
+    {'[', 'F', 0, 0, LWCLI_KEY_END},
+    {'O', 'A', 0, 0, LWCLI_KEY_UP},
+    {'O', 'B', 0, 0, LWCLI_KEY_DOWN},
+    {'O', 'C', 0, 0, LWCLI_KEY_RIGHT},
+    {'O', 'D', 0, 0, LWCLI_KEY_LEFT},
+    {'O', 'H', 0, 0, LWCLI_KEY_HOME},
+    {'O', 'F', 0, 0, LWCLI_KEY_END},
+    {'[', '~', 1, 0, LWCLI_KEY_HOME},
+    {'[', '~', 7, 0, LWCLI_KEY_HOME},
+    {'[', '~', 4, 0, LWCLI_KEY_END},
+    {'[', '~', 8, 0, LWCLI_KEY_END},
+    {'[', '~', 3, 0, LWCLI_KEY_DELETE},
+    {'[', 'C', 0, 5, LWCLI_KEY_WORD_RIGHT},
+    {'[', 'D', 0, 5, LWCLI_KEY_WORD_LEFT},
+    {'[', '~', 200, 0, LWCLI_KEY_PASTE_BEGIN},
+    {'[', '~', 201, 0, LWCLI_KEY_PASTE_END},
+    {'O', 'P', 0, 0, LWCLI_KEY_F1},
+    {'O', 'Q', 0, 0, LWCLI_KEY_F1 + 1},
+    {'O', 'R', 0, 0, LWCLI_KEY_F1 + 2},
+    {'O', 'S', 0, 0, LWCLI_KEY_F1 + 3},
+    {'[', '~', 11, 0, LWCLI_KEY_F1},
+    {'[', '~', 12, 0, LWCLI_KEY_F1 + 1},
+    {'[', '~', 13, 0, LWCLI_KEY_F1 + 2},
+    {'[', '~', 14, 0, LWCLI_KEY_F1 + 3},
+    {'[', '~', 15, 0, LWCLI_KEY_F1 + 4},
+    {'[', '~', 17, 0, LWCLI_KEY_F1 + 5},
+    {'[', '~', 18, 0, LWCLI_KEY_F1 + 6},
+    {'[', '~', 19, 0, LWCLI_KEY_F1 + 7},
+    {'[', '~', 20, 0, LWCLI_KEY_F1 + 8},
+    {'[', '~', 21, 0, LWCLI_KEY_F1 + 9},
+    {'[', '~', 23, 0, LWCLI_KEY_F1 + 10},
+    {'[', '~', 24, 0, LWCLI_KEY_F1 + 11},
+};
+
+/**
+ * @brief 解码结束的转义序列并分发到按键处理表
+ * @param intro 引导字符（'[' 或 'O'）
+ * @param final 结束字符
+ * @note 每个序列只在结束时查表一次，逐字节路径上没有按键相关的分支
+ */
+static void lwcli_ansi_dispatch(char intro, char final)
+{
+    uint16_t code = (final == '~') ? lwcliObj.ansiParam[0] : 0;
+    uint16_t modifier = (lwcliObj.ansiParam[1] > 1) ? lwcliObj.ansiParam[1] : 0;
+    for (size_t i = 0; i < sizeof(lwcli_ansi_key_table) / sizeof(lwcli_ansi_key_table[0]); i++) {
+        const lwcli_ansi_key_t *entry = &lwcli_ansi_key_table[i];
+        if (entry->intro == intro && entry->final == final && entry->code == code && entry->modifier == modifier) {
+#if (LWCLI_BRACKETED_PASTE == LWCLI_TRUE)
+            if (lwcliObj.pasting && entry->key != LWCLI_KEY_PASTE_END) {
+                return;     /* 粘贴内容中的转义序列不作为按键处理 */
+            }
+#endif  // LWCLI_BRACKETED_PASTE == LWCLI_TRUE
+            if (lwcli_key_handler[entry->key] != NULL) {
+                lwcli_key_handler[entry->key]();
+            }
+#if (LWCLI_USING_HOTKEY == LWCLI_TRUE)
+            else if (entry->key >= LWCLI_KEY_F1) {
+                lwcli_hotkey_run((uint8_t)(LWCLI_HOTKEY_F1 + (entry->key - LWCLI_KEY_F1)));
+            }
+#endif  // LWCLI_USING_HOTKEY == LWCLI_TRUE
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 转义序列解析（ESC、CSI 与 SS3）
+ * @param c 接收到的字符
+ * @return true 字符属于转义序列已被消耗；false 序列被控制字符打断，该字符需按普通输入处理
+ * @note 每个字节 O(1)：CSI 参数饱和累加，任意结束字符（0x40 - 0x7E）结束序列，
+ *       未知序列直接丢弃，不会残留在输入缓冲区中
+ */
+static bool lwcli_ansi_parse(char c)
+{
+    uint8_t byte = (uint8_t)c;
+    if (byte < 0x20 || byte >= 0x7F) {
+        lwcliObj.ansiState = LWCLI_ANSI_STATE_NONE;
+        return false;
+    }
+    switch (lwcliObj.ansiState) {
+        case LWCLI_ANSI_STATE_ESC:
+            lwcliObj.ansiParam[0] = 0;
+            lwcliObj.ansiParam[1] = 0;
+            lwcliObj.ansiParamNum = 0;
+            lwcliObj.ansiState = (c == '[') ? LWCLI_ANSI_STATE_CSI
+                               : (c == 'O') ? LWCLI_ANSI_STATE_SS3 : LWCLI_ANSI_STATE_NONE;
+            break;
+        case LWCLI_ANSI_STATE_CSI:
+            if (c >= '0' && c <= '9') {
+                if (lwcliObj.ansiParamNum < 2 && lwcliObj.ansiParam[lwcliObj.ansiParamNum] < 1000) {
+                    lwcliObj.ansiParam[lwcliObj.ansiParamNum] = lwcliObj.ansiParam[lwcliObj.ansiParamNum] * 10 + (c - '0');
+                }
+            }
+            else if (c == ';') {
+                if (lwcliObj.ansiParamNum < 2) {
+                    lwcliObj.ansiParamNum++;
+                }
+            }
+            else if (byte >= 0x40) {
+                lwcliObj.ansiState = LWCLI_ANSI_STATE_NONE;
+                lwcli_ansi_dispatch('[', c);
+            }
+            /* 其余参数/中间字符（如 '?'）忽略 */
+            break;
+        case LWCLI_ANSI_STATE_SS3:
+            lwcliObj.ansiState = LWCLI_ANSI_STATE_NONE;
+            lwcli_ansi_dispatch('O', c);
+            break;
+        default:
+            lwcliObj.ansiState = LWCLI_ANSI_STATE_NONE;
+            break;
+    }
+    return true;
+}
+
+/**
+ * @brief 行编辑：处理一个输入字符
+ * @param recv_char 接收到的字符
+ */
+static void lwcli_input_char(char recv_char)
+{
+    if (lwcliObj.ansiState != LWCLI_ANSI_STATE_NONE && lwcli_ansi_parse(recv_char)) {
+        return;
+    }
+#if (LWCLI_BRACKETED_PASTE == LWCLI_TRUE)
+    if (lwcliObj.pasting && recv_char != '\033') {
+        lwcli_paste_char(recv_char);
+        return;
+    }
+#endif  // LWCLI_BRACKETED_PASTE == LWCLI_TRUE
+#if (LWCLI_USING_HOTKEY == LWCLI_TRUE)
+    if ((uint8_t)recv_char < LWCLI_HOTKEY_F1 && lwcliObj.hotkey[(uint8_t)recv_char] != NULL) {
+        lwcli_hotkey_run((uint8_t)recv_char);
+        return;
+    }
+#endif  // LWCLI_USING_HOTKEY == LWCLI_TRUE
+    if (recv_char == '\r' || recv_char == '\n') {
+        lwcli_line_sync();
+        lwcli_input_gap_close();
+        lwcli_opt_output("\r\n", 2);
+        lwcli_command_execute(lwcliObj.inputBuffer, lwcliObj.inputBufferPos, &lwcliObj.line);
+        lwcliObj.inputBuffer[0] = '\0';
+        lwcliObj.inputBufferPos = 0;
+        lwcliObj.cursorPos = 0;
+        lwcli_line_reset(&lwcliObj.line);
+    }
+    else if ((recv_char == '\b' || recv_char == ansi_delete)) {
+        if (lwcliObj.cursorPos == 0) {
+            return;
+        }
+        lwcliObj.cursorPos--;
+        lwcliObj.inputBufferPos--;
+        lwcliObj.line.dirty = true;
+        lwcli_line_update(lwcliObj.cursorPos + 1, lwcliObj.inputBufferPos + 1, lwcliObj.cursorPos);
+    }
+    else if (recv_char == '\t') {
+        lwcli_line_sync();
+        lwcli_input_gap_close();
+        lwcli_table_process();
+        lwcli_input_gap_open();
+        lwcliObj.line.dirty = true;
+    }
+    else if (recv_char == '\033') {
+        lwcliObj.ansiState = LWCLI_ANSI_STATE_ESC;
+    }
+    else {
+        lwcli_assert(lwcliObj.inputBufferPos < sizeof(lwcliObj.inputBuffer) - 1);
+        lwcliObj.inputBuffer[lwcliObj.cursorPos++] = recv_char;
+        lwcliObj.inputBufferPos++;
+        if (lwcliObj.cursorPos == lwcliObj.inputBufferPos) { // 普通字符且光标处于最后
+            lwcli_opt_output(&recv_char, 1);
+            lwcli_line_sync();
+        }
+        else {   // 普通字符但光标不是在最后
+            lwcliObj.line.dirty = true;
+            lwcli_line_update(lwcliObj.cursorPos - 1, lwcliObj.inputBufferPos - 1, lwcliObj.cursorPos - 1);
+        }
+    }
+}
+
+/**
+ * @brief 是否处于原始数据模式
+ */
+static inline bool lwcli_raw_active(void)
+{
+#if (LWCLI_USING_RAW_MODE == LWCLI_TRUE)
+    return lwcliObj.rawConsumer != NULL;
+#else
+    return false;
+#endif  // LWCLI_USING_RAW_MODE == LWCLI_TRUE
+}
+
+#if (LWCLI_USING_RAW_MODE == LWCLI_TRUE)
+/**
+ * @brief 原始模式：把数据作为一个块交给 consumer
+ * @param buf 接收到的数据
+ * @param len 数据长度
+ * @return 消耗的字节数（含结束字节），原始模式结束后剩余的数据按普通输入处理
+ */
+static size_t lwcli_raw_input(const char *buf, size_t len)
+{
+    bool limited = (lwcliObj.rawRemain != 0);
+    size_t n = (limited && lwcliObj.rawRemain < len) ? lwcliObj.rawRemain : len;
+    size_t used = n;
+    bool last = limited && (n == lwcliObj.rawRemain);
+    if (lwcliObj.rawTerminator != LWCLI_RAW_NO_TERMINATOR) {
+        const char *end = (const char *)memchr(buf, lwcliObj.rawTerminator, n);
+        if (end != NULL) {
+            n = (size_t)(end - buf);
+            used = n + 1;
+            last = true;
+        }
+    }
+    if (limited) {
+        lwcliObj.rawRemain -= n;
+    }
+    lwcli_raw_f consumer = lwcliObj.rawConsumer;
+    if (last) {
+        lwcliObj.rawConsumer = NULL;    /* 先退出，consumer 中可以再次进入原始模式 */
+    }
+    if (n > 0 || last) {
+        lwcli_flush_before_callback();
+        consumer(buf, n, last);
+    }
+    if (last && !lwcli_raw_active()) {
+        lwcli_input_redraw();
+    }
+    return used;
+}
+#endif  // LWCLI_USING_RAW_MODE == LWCLI_TRUE
+
+/**
+ * @brief 处理一个接收到的字符
+ * @param recv_char 接收到的字符
+ */
+static void lwcli_receive_char(char recv_char)
+{
+#if (LWCLI_USING_RAW_MODE == LWCLI_TRUE)
+    if (lwcli_raw_active()) {
+        lwcli_raw_input(&recv_char, 1);
+        return;
+    }
+#endif  // LWCLI_USING_RAW_MODE == LWCLI_TRUE
+    lwcli_input_char(recv_char);
+#if (LWCLI_COMMAND_HIGHLIGHT == LWCLI_TRUE)
+    lwcli_highlight_update();
+#endif  // LWCLI_COMMAND_HIGHLIGHT == LWCLI_TRUE
+}
+
+/**
+ * @brief 是否为普通输入字符（非控制字符与 DEL）
+ * @note 换行、退格、Tab、ESC 与热键均为控制字符，逐字节处理
+ * @param c 字符
+ * @return true 普通字符
+ */
+static inline bool lwcli_is_plain_char(char c)
+{
+    return (uint8_t)c >= 0x20 && c != ansi_delete;
+}
+
+/**
+ * @brief 是否正在接收括号粘贴的内容
+ */
+static inline bool lwcli_input_pasting(void)
+{
+#if (LWCLI_BRACKETED_PASTE == LWCLI_TRUE)
+    return lwcliObj.pasting;
+#else
+    return false;
+#endif  // LWCLI_BRACKETED_PASTE == LWCLI_TRUE
+}
+
+/**
+ * @brief 处理一段接收到的数据
+ * @param buf 接收到的数据
+ * @param len 数据长度
+ * @note 光标位于行尾时，连续的普通字符一次性追加到输入缓冲区并只回显一次；
+ *       括号粘贴期间连续的普通字符直接插入光标处且不回显；
+ *       控制字符与转义序列逐字节交给 lwcli_receive_char() 处理
+ */
+static void lwcli_receive_buffer(const char *buf, size_t len)
+{
+    size_t i = 0;
+    while (i < len) {
+#if (LWCLI_USING_RAW_MODE == LWCLI_TRUE)
+        if (lwcli_raw_active()) {
+            i += lwcli_raw_input(buf + i, len - i);
+            continue;
+        }
+#endif  // LWCLI_USING_RAW_MODE == LWCLI_TRUE
+        bool pasting = lwcli_input_pasting();
+        if (lwcliObj.ansiState == LWCLI_ANSI_STATE_NONE && (pasting || lwcliObj.cursorPos == lwcliObj.inputBufferPos)) {
+            size_t room = sizeof(lwcliObj.inputBuffer) - 1 - lwcliObj.inputBufferPos;
+            size_t run = 0;
+            while (run < room && i + run < len && lwcli_is_plain_char(buf[i + run])) {
+                run++;
+            }
+            if (run > 0) {
+                memcpy(lwcliObj.inputBuffer + lwcliObj.cursorPos, buf + i, run);
+                lwcliObj.inputBufferPos += (uint16_t)run;
+                lwcliObj.cursorPos += (uint16_t)run;
+                if (!pasting) {
+                    lwcli_opt_output(buf + i, (uint16_t)run);
+                    lwcli_line_sync();
+#if (LWCLI_COMMAND_HIGHLIGHT == LWCLI_TRUE)
+                    lwcli_highlight_update();
+#endif  // LWCLI_COMMAND_HIGHLIGHT == LWCLI_TRUE
+                }
+                i += run;
+                continue;
+            }
+        }
+        lwcli_receive_char(buf[i++]);
+    }
+}
+
+#if (LWCLI_DEFERRED_INPUT == LWCLI_TRUE)
+/**
+ * @brief 编译器内存屏障：禁止编译器把屏障两侧的内存访问重排
+ * @note 接收中断与 lwcli_poll() 运行在同一核上，编译器屏障即可保证 ring[] 的写入先于 ringHead 发布、
+ *       读取先于 ringTail 释放
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define lwcli_compiler_barrier()    __asm__ volatile("" ::: "memory")
+#elif defined(__CC_ARM)
+#define lwcli_compiler_barrier()    __schedule_barrier()
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define lwcli_compiler_barrier()    atomic_signal_fence(memory_order_seq_cst)
+#else
+#error "lwcli_compiler_barrier() is not defined for this compiler"
+#endif
+
+/**
+ * @brief 把接收到的数据写入输入环形缓冲区
+ * @note 单生产者（接收中断）/ 单消费者（lwcli_poll）无锁：生产者只写 ringHead，消费者只写 ringTail；
+ *       每字节 O(1)，缓冲区满时丢弃后续数据
+ * @param buf 接收到的数据
+ * @param len 数据长度
+ */
+static void lwcli_ring_put(const char *buf, size_t len)
+{
+    uint16_t head = lwcliObj.ringHead;
+    for (size_t i = 0; i < len; i++) {
+        uint16_t next = (head + 1) & (LWCLI_INPUT_RING_SIZE - 1);
+        if (next == lwcliObj.ringTail) {
+            break;
+        }
+        lwcliObj.ring[head] = buf[i];
+        head = next;
+    }
+    lwcli_compiler_barrier();   /* 数据写入完成后再发布 ringHead */
+    lwcliObj.ringHead = head;
+}
+#endif  // LWCLI_DEFERRED_INPUT == LWCLI_TRUE
+
+/**
+ * @brief 接收处理字符
+ * @param recv_char 接收到的字符
+ */
+void lwcli_process_receive_char(char recv_char)
+{
+#if (LWCLI_DEFERRED_INPUT == LWCLI_TRUE)
+    lwcli_ring_put(&recv_char, 1);
+#else
+    lwcli_output_hold();
+    lwcli_receive_char(recv_char);
+    lwcli_output_release();
+#endif  // LWCLI_DEFERRED_INPUT == LWCLI_TRUE
+}
+
+/**
+ * @brief 批量接收处理字符
+ * @param buf 接收到的数据
+ * @param len 数据长度
+ */
+void lwcli_process_receive_buffer(const char *buf, size_t len)
+{
+#if (LWCLI_DEFERRED_INPUT == LWCLI_TRUE)
+    lwcli_ring_put(buf, len);
+#else
+    lwcli_output_hold();
+    lwcli_receive_buffer(buf, len);
+    lwcli_output_release();
+#endif  // LWCLI_DEFERRED_INPUT == LWCLI_TRUE
+}
+
+#if (LWCLI_DEFERRED_INPUT == LWCLI_TRUE)
+/**
+ * @brief 处理环形缓冲区中已接收的数据
+ * @note 行编辑、回显、补全与命令分发都在这里执行；每段连续数据整块处理，处理完再释放空间
+ */
+void lwcli_poll(void)
+{
+    uint16_t tail = lwcliObj.ringTail;
+    uint16_t head;
+    lwcli_output_hold();
+    while ((head = lwcliObj.ringHead) != tail) {
+        lwcli_compiler_barrier();   /* 读到 ringHead 之后再读取数据 */
+        uint16_t end = (head > tail) ? head : LWCLI_INPUT_RING_SIZE;
+        lwcli_receive_buffer(lwcliObj.ring + tail, end - tail);
+        tail = end & (LWCLI_INPUT_RING_SIZE - 1);
+        lwcli_compiler_barrier();   /* 数据处理完成后再释放空间 */
+        lwcliObj.ringTail = tail;
+    }
+    lwcli_output_release();
+}
+#endif  // LWCLI_DEFERRED_INPUT == LWCLI_TRUE
+
+/**
+ * @brief 比较命令名的前 len 个字符
+ * @param a 命令名 a
+ * @param b 命令名 b
+ * @param len 比较长度
+ * @return <0 / 0 / >0，LWCLI_COMMAND_IGNORE_CASE 启用时忽略大小写
+ */
+static int lwcli_name_compare(const char *a, const char *b, uint16_t len)
+{
+#if (LWCLI_COMMAND_IGNORE_CASE == LWCLI_TRUE)
+    for (uint16_t i = 0; i < len; i++) {
+        int diff = (uint8_t)LWCLI_CASE_FOLD(a[i]) - (uint8_t)LWCLI_CASE_FOLD(b[i]);
+        if (diff != 0) {
+            return diff;
+        }
+    }
+    return 0;
+#else
+    return lwcli_str_compare(a, b, len);
+#endif  // LWCLI_COMMAND_IGNORE_CASE == LWCLI_TRUE
+}
+
+/**
+ * @brief 通过哈希索引查找某个节点下名为 token 的已挂载子命令
+ * @param parent 父节点热数据下标 + 1，0 为根
+ * @param token 子命令名（无需以 '\0' 结尾）
+ * @param len 子命令名长度
+ * @return 命中的命令热数据，未找到或所属模块未挂载返回 NULL
+ */
+static command_hot_t *lwcli_find_child(uint16_t parent, const char *token, uint16_t len)
+{
+    command_hot_t *hot = lwcli_find_node(parent, token, len);
+    return (hot != NULL && lwcli_command_visible(hot)) ? hot : NULL;
+}
+
+/**
+ * @brief 通过哈希索引查找某个节点下名为 token 的子命令（含未挂载模块的命令）
+ * @param parent 父节点热数据下标 + 1，0 为根
+ * @param token 子命令名（无需以 '\0' 结尾）
+ * @param len 子命令名长度
+ * @return 命中的命令热数据，未找到返回 NULL
+ */
+static command_hot_t *lwcli_find_node(uint16_t parent, const char *token, uint16_t len)
+{
+    return lwcli_find_node_hash(parent, lwcli_token_hash(parent, token, len), token, len);
+}
+
+/**
+ * @brief 计算某个节点下子命令名的哈希
+ * @param parent 父节点热数据下标 + 1，0 为根
+ * @param token 子命令名
+ * @param len 子命令名长度
+ * @return 哈希值，与增量解析逐字符累加的结果一致
+ */
+static uint32_t lwcli_token_hash(uint16_t parent, const char *token, uint16_t len)
+{
+    uint32_t hash = LWCLI_HASH_SEED(parent);
+    for (uint16_t i = 0; i < len; i++) {
+        hash = LWCLI_HASH_STEP(hash, LWCLI_CASE_FOLD(token[i]));
+    }
+    return hash;
+}
+
+/**
+ * @brief 以已算好的哈希查找子命令（含未挂载模块的命令）
+ * @param parent 父节点热数据下标 + 1，0 为根
+ * @param hash lwcli_token_hash() 或增量解析得到的哈希
+ * @param token 子命令名
+ * @param len 子命令名长度
+ * @return 命中的命令热数据，未找到返回 NULL
+ */
+static command_hot_t *lwcli_find_node_hash(uint16_t parent, uint32_t hash, const char *token, uint16_t len)
+{
+    if (len == 0 || len >= LWCLI_COMMAND_STR_MAX_LENGTH) {
+        return NULL;
+    }
+    uint16_t slot = hash & (LWCLI_COMMAND_HASH_SIZE - 1);
+    while (lwcliObj.command_index[slot] != 0) {
+        command_hot_t *hot = &lwcliObj.command_hot[lwcliObj.command_index[slot] - 1];
+        if (hot->hash == hash && hot->parent == parent) {
+            uint16_t offset = lwcli_command_name_offset(hot);
+            if (hot->cmd_len - offset == len && lwcli_name_compare(hot->desc->command + offset, token, len) == 0) {
+                return hot;
+            }
+        }
+        slot = (slot + 1) & (LWCLI_COMMAND_HASH_SIZE - 1);
+    }
+    return NULL;
+}
+
+/**
+ * @brief 解析用户输入的子命令名
+ * @note 先做哈希精确查找；启用 LWCLI_COMMAND_ABBREVIATION 时，未命中则在有序索引中
+ *       二分查找前缀区间，已挂载命令中唯一以 token 开头的命令视为其缩写
+ * @param parent 父节点热数据下标 + 1，0 为根
+ * @param token 输入的子命令名
+ * @param len 输入长度
+ * @return 命中的命令热数据，未找到或缩写有歧义返回 NULL
+ */
+static command_hot_t *lwcli_resolve_child(uint16_t parent, const char *token, uint16_t len)
+{
+    return lwcli_resolve_child_hash(parent, lwcli_token_hash(parent, token, len), token, len);
+}
+
+/**
+ * @brief 以已算好的哈希解析用户输入的子命令名，规则同 lwcli_resolve_child()
+ * @param parent 父节点热数据下标 + 1，0 为根
+ * @param hash 输入子命令名的哈希
+ * @param token 输入的子命令名
+ * @param len 输入长度
+ * @return 命中的命令热数据，未找到或缩写有歧义返回 NULL
+ */
+static command_hot_t *lwcli_resolve_child_hash(uint16_t parent, uint32_t hash, const char *token, uint16_t len)
+{
+    command_hot_t *hot = lwcli_find_node_hash(parent, hash, token, len);
+    if (hot != NULL && !lwcli_command_visible(hot)) {
+        hot = NULL;
+    }
+#if (LWCLI_COMMAND_ABBREVIATION == LWCLI_TRUE)
+    if (hot == NULL && len > 0) {
+        uint16_t first = 0;
+        uint16_t num = lwcli_command_prefix_range(parent, token, len, &first);
+        if (lwcli_command_visible_range(&first, &num) == 1) {
+            hot = &lwcliObj.command_hot[lwcliObj.command_sorted[first]];
+        }
+    }
+#endif  // LWCLI_COMMAND_ABBREVIATION == LWCLI_TRUE
+    return hot;
+}
+
+#if (LWCLI_COMMAND_ABBREVIATION == LWCLI_TRUE)
+/**
+ * @brief 缩写有歧义时列出所有候选命令
+ * @param parent 父节点热数据下标 + 1，0 为根
+ * @param token 输入的子命令名
+ * @param len 输入长度
+ * @return true 有歧义并已输出候选命令
+ */
+static bool lwcli_output_candidates(uint16_t parent, const char *token, uint16_t len)
+{
+    uint16_t first = 0;
+    uint16_t num = (len > 0) ? lwcli_command_prefix_range(parent, token, len, &first) : 0;
+    if (lwcli_command_visible_range(&first, &num) < 2) {
+        return false;
+    }
+    lwcli_printf("Error: \"%.*s\" is ambiguous, candidates:\r\n", len, token);
+    for (uint16_t i = first; i < first + num; i++) {
+        const command_hot_t *hot = &lwcliObj.command_hot[lwcliObj.command_sorted[i]];
+        if (lwcli_command_visible(hot)) {
+            lwcli_help_output_brief(hot);
+        }
+    }
+    return true;
+}
+#endif  // LWCLI_COMMAND_ABBREVIATION == LWCLI_TRUE
+
+/**
+ * @brief 沿命令树逐个 token 查找命令
+ * @note 每一级只做一次哈希查找，复杂度 O(层数)；第一个不是子命令的 token 及其后为参数
+ * @param input 输入字符串
+ * @param input_len 输出：已匹配的命令部分在 input 中的长度，可为 NULL
+ * @param abbreviate 是否接受唯一前缀缩写（Tab 补全时须为 false）
+ * @return 匹配到的最深一级命令，未找到返回 NULL
+ */
+static command_hot_t *lwcli_find_command(const char *input, uint16_t *input_len, bool abbreviate)
+{
+    command_hot_t *hot = NULL;
+    uint16_t pos = 0, matched = 0;
+    while (1) {
+        if (hot != NULL) {
+            while (input[pos] == ' ') pos++;
+        }
+        uint16_t start = pos;
+        while (input[pos] && input[pos] != ' ') {
+            pos++;
         }
-        if (!found || cmd == NULL) {
-            lwcli_printf("Error: \"%s\" not found. Enter \"help\" to view available commands.\r\n", search);
-            return;
+        uint16_t parent = (hot != NULL) ? (uint16_t)(hot - lwcliObj.command_hot) + 1 : 0;
+        command_hot_t *child = abbreviate ? lwcli_resolve_child(parent, input + start, pos - start)
+                                          : lwcli_find_child(parent, input + start, pos - start);
+        if (child == NULL) {
+            break;
         }
-        lwcli_printf("%s  %s\r\n", cmd->command, cmd->brief);
+        hot = child;
+        matched = pos;
     }
+    if (input_len != NULL) {
+        *input_len = matched;
+    }
+    return hot;
 }
-#endif  // LWCLI_PARAMETER_SPLIT == LWCLI_TRUE
 
 /**
- * @brief 清屏命令
+ * @brief 复位增量解析状态（空行）
+ * @param line 解析状态
+ */
+static void lwcli_line_reset(lwcli_line_t *line)
+{
+    memset(line, 0, sizeof(*line));
+}
+
+/**
+ * @brief 记录一个参数的起始位置
+ * @param line 解析状态
+ * @param start 参数起始下标
  */
+static inline void lwcli_line_add_arg(lwcli_line_t *line, uint16_t start)
+{
 #if (LWCLI_PARAMETER_SPLIT == LWCLI_TRUE)
-static void lwcli_clear(int argc, char *argv[])
+    if (line->argc < LWCLI_PARAMETER_MAX_NUM) {
+        line->argStart[line->argc] = start;
+        line->argEnd[line->argc] = 0;
+        line->argc++;
+    }
 #else
-static void lwcli_clear(char *argvs)
+    (void)line;
+    (void)start;
 #endif  // LWCLI_PARAMETER_SPLIT == LWCLI_TRUE
-{
-    lwcli_opt_output(ansi_clear_screen, sizeof(ansi_clear_screen));
-    lwcli_printf(ansi_cursor_move_to, 0, 0);
 }
 
-
 /**
- * @brief printf 函数
- * @param format 
- * @param  
+ * @brief token 结束（遇到分隔空格）
+ * @note 命令路径尚未结束时以累加好的哈希查找子命令，一次哈希查找即可确定是子命令还是第一个参数
+ * @param line 解析状态
+ * @param text 输入行
+ * @param pos 分隔空格的下标
  */
-static void lwcli_printf(const char *format, ...)
+static void lwcli_line_token_end(lwcli_line_t *line, const char *text, uint16_t pos)
 {
-    va_list args;
-    va_start(args, format);
-    int ret = vsnprintf(lwcliObj.ouputBuffer, sizeof(lwcliObj.ouputBuffer), format, args);
-    va_end(args);
-    uint16_t print_len = (ret < 0 || (size_t)ret >= sizeof(lwcliObj.ouputBuffer))
-                        ? (uint16_t)(sizeof(lwcliObj.ouputBuffer) - 1) : (uint16_t)ret;
-    lwcli_opt_output(lwcliObj.ouputBuffer, print_len);
+    line->inToken = false;
+    if (line->firstEnd == 0) {
+        line->firstEnd = pos;
+    }
+    if (!line->cmdDone) {
+        uint16_t len = pos - line->tokenStart;
+#if (LWCLI_COMMAND_ABBREVIATION == LWCLI_TRUE)
+        command_hot_t *hot = lwcli_resolve_child_hash(line->parent, line->tokenHash, text + line->tokenStart, len);
+#else
+        command_hot_t *hot = lwcli_find_node_hash(line->parent, line->tokenHash, text + line->tokenStart, len);
+        if (hot != NULL && !lwcli_command_visible(hot)) {
+            hot = NULL;
+        }
+#endif  // LWCLI_COMMAND_ABBREVIATION == LWCLI_TRUE
+        if (hot != NULL) {
+            line->parent = (uint16_t)(hot - lwcliObj.command_hot) + 1;
+            line->cmdEnd = pos;
+            return;
+        }
+        line->cmdDone = true;
+        lwcli_line_add_arg(line, line->tokenStart);
+    }
+#if (LWCLI_PARAMETER_SPLIT == LWCLI_TRUE)
+    if (line->argc > 0 && line->argEnd[line->argc - 1] == 0) {
+        line->argEnd[line->argc - 1] = pos;
+    }
+#endif  // LWCLI_PARAMETER_SPLIT == LWCLI_TRUE
 }
 
 /**
- * @brief 接收处理字符
- * @param recv_char 接收到的字符
+ * @brief 增量解析：处理 text[pos]
+ * @note 每个字符 O(1)：更新 token 边界、引号与转义状态、命令名哈希，token 结束时做一次哈希查找
+ * @param line 解析状态
+ * @param text 输入行，text[0, pos] 须连续
+ * @param pos 新字符的下标
  */
-void lwcli_process_receive_char(char recv_char)
+static void lwcli_line_step(lwcli_line_t *line, const char *text, uint16_t pos)
 {
-    static uint8_t ansiKey = 0;
-    if (recv_char == '\r' || recv_char == '\n') {
-        ansiKey = 0;
-        lwcliObj.inputBuffer[lwcliObj.inputBufferPos] = '\0';
-        lwcli_opt_output("\r\n", 2);
-        lwcli_process_command(lwcliObj.inputBuffer);
-        #if (LWCLI_HISTORY_COMMAND_NUM > 0)
-        if (lwcliObj.inputBufferPos > 0){
-            lwcli_add_history_command();
+    char c = text[pos];
+    bool literal = line->escaped;
+    line->escaped = (!literal && c == '\\');
+    if (line->inToken) {
+        if (literal) {
+            /* 转义字符不分隔 token、不改变引号状态 */
         }
-        #endif  // LWCLI_HISTORY_COMMAND_NUM > 0
-        memset(lwcliObj.inputBuffer, 0, sizeof(lwcliObj.inputBuffer));
-        lwcliObj.inputBufferPos = 0;
-        lwcliObj.cursorPos = 0;
-    }
-    else if ((recv_char == '\b' || recv_char == ansi_delete)) {
-        if (lwcliObj.inputBufferPos == 0) {
+        else if (line->inQuotes) {
+            line->inQuotes = (c != '\"');
+        }
+        else if (c == ' ') {
+            lwcli_line_token_end(line, text, pos);
             return;
         }
-        if (lwcliObj.cursorPos == lwcliObj.inputBufferPos) {
-            lwcliObj.inputBuffer[--lwcliObj.inputBufferPos] = '\0';
-            lwcli_printf(lwcli_delete);
-            lwcliObj.cursorPos = lwcliObj.inputBufferPos;
+        else if (c == '\"') {
+            line->inQuotes = true;
         }
-        else if (lwcliObj.cursorPos > 0) {
-            for (size_t i = lwcliObj.cursorPos - 1; i < lwcliObj.inputBufferPos; i++) // 字符串缓存处理，保证cmdStrBuffer中存储的字符串和屏幕一致
-            {
-                lwcliObj.inputBuffer[i] = lwcliObj.inputBuffer[i + 1];
-            }
-            lwcli_printf("%s%s%s%s%s", ansi_clear_behind, lwcli_delete, ansi_cursor_save, &lwcliObj.inputBuffer[lwcliObj.cursorPos - 1], ansi_cursor_restore);
-            lwcliObj.inputBufferPos--;
-            lwcliObj.cursorPos--;
+        if (!line->cmdDone) {
+            line->tokenHash = LWCLI_HASH_STEP(line->tokenHash, LWCLI_CASE_FOLD(c));
         }
     }
-    else if (recv_char == '\t') {
-        lwcli_table_process();
-    }
-    else if (recv_char == '\033') {
-        ansiKey = 1;
-    }
-    else {
-        if (ansiKey == 0) {
-            lwcli_assert(lwcliObj.inputBufferPos < sizeof(lwcliObj.inputBuffer) - 1);
-            if (lwcliObj.cursorPos == lwcliObj.inputBufferPos) { // 普通字符且光标处于最后
-                lwcliObj.inputBuffer[lwcliObj.inputBufferPos++] = recv_char;
-                lwcliObj.cursorPos = lwcliObj.inputBufferPos;
-                lwcli_opt_output(&recv_char, 1);
-            }
-            else {   // 普通字符但光标不是在最后
-                lwcli_printf("%c%s%s%s", recv_char, ansi_cursor_save, lwcliObj.inputBuffer + lwcliObj.cursorPos, ansi_cursor_restore);
-                
-                for (size_t i = lwcliObj.inputBufferPos; i > lwcliObj.cursorPos; i--) {// 字符串缓存处理，保证cmdStrBuffer中存储的字符串和屏幕一致
-                    lwcliObj.inputBuffer[i] = lwcliObj.inputBuffer[i - 1];
-                }
-                lwcliObj.inputBuffer[lwcliObj.cursorPos] = recv_char;
-                lwcliObj.inputBufferPos++;
-                lwcliObj.cursorPos++;
-            }
+    else if (c != ' ') {
+        line->inToken = true;
+        line->inQuotes = (c == '\"');
+        line->tokenStart = pos;
+        if (line->cmdDone) {
+            lwcli_line_add_arg(line, pos);
         }
-        else if (ansiKey == 1) {
-            ansiKey++;
+        else {
+            line->tokenHash = LWCLI_HASH_STEP(LWCLI_HASH_SEED(line->parent), LWCLI_CASE_FOLD(c));
         }
-        else if (ansiKey == 2) {
-            ansiKey = 0;
-            if (recv_char == 'C') {
-                if (lwcliObj.cursorPos < lwcliObj.inputBufferPos) {
-                    lwcliObj.cursorPos++;
-                    lwcli_opt_output(ansi_cursor_right, sizeof(ansi_cursor_right));
-                }
-            }
-            else if (recv_char == 'D') {
-                if (lwcliObj.cursorPos > 0) {
-                    lwcliObj.cursorPos--;
-                    lwcli_opt_output(ansi_cursor_left, sizeof(ansi_cursor_left));
-                }
+    }
+    else if (pos == 0) {
+        line->cmdDone = true;   /* 行首为空格时不匹配命令 */
+    }
+}
+
+/**
+ * @brief 解析 text[from, to)
+ * @param line 解析状态，须已解析到 from
+ * @param text 输入行
+ * @param from 起始下标
+ * @param to 结束下标
+ */
+static void lwcli_line_parse(lwcli_line_t *line, const char *text, uint16_t from, uint16_t to)
+{
+    uint16_t i = from;
+    while (i < to) {
+        if (line->cmdDone && !line->escaped && i > 0) {
+            /* 参数部分不计算哈希，只有空格、引号、反斜杠会改变状态，按字跳过其余字符 */
+            if (line->inToken) {
+                i += lwcli_str_find3(text + i, to - i, line->inQuotes ? '\"' : ' ', '\"', '\\');
             }
-            #if (LWCLI_HISTORY_COMMAND_NUM > 0)
-            else if (recv_char == 'A') {
-                lwcli_history_command_up();
+            else {
+                i += lwcli_str_skip(text + i, to - i, ' ');
             }
-            else if (recv_char == 'B') {
-                lwcli_history_command_down();
+            if (i >= to) {
+                break;
             }
-            #endif  // LWCLI_HISTORY_COMMAND_NUM > 0
+        }
+        lwcli_line_step(line, text, i++);
+    }
+    line->parsedLen = to;
+}
+
+/**
+ * @brief 使输入行的解析状态与 inputBuffer 一致
+ * @note 只有非行尾追加的编辑（删除、行中插入、历史、补全、粘贴）之后才需要整行重新解析
+ */
+static void lwcli_line_sync(void)
+{
+    lwcli_line_t *line = &lwcliObj.line;
+    if (!line->dirty && line->parsedLen == lwcliObj.inputBufferPos) {
+        return;
+    }
+    lwcli_input_gap_close();
+    if (line->dirty) {
+        lwcli_line_reset(line);
+    }
+    lwcli_line_parse(line, lwcliObj.inputBuffer, line->parsedLen, lwcliObj.inputBufferPos);
+    lwcli_input_gap_open();
+}
+
+/**
+ * @brief 取得已解析命令行中的命令
+ * @note 最后一个 token 尚未结束时，按其当前内容查找（Tab 补全要求精确匹配，分发时接受缩写）
+ * @param line 解析状态
+ * @param text 输入行
+ * @param abbreviate 最后一个未结束的 token 是否接受唯一前缀缩写
+ * @param cmd_end 输出：命令部分（含子命令）在行中的结束下标
+ * @return 匹配到的最深一级命令，未找到返回 NULL
+ */
+static command_hot_t *lwcli_line_command(const lwcli_line_t *line, const char *text, bool abbreviate, uint16_t *cmd_end)
+{
+    if (line->inToken && !line->cmdDone) {
+        uint16_t len = line->parsedLen - line->tokenStart;
+        command_hot_t *hot = abbreviate ? lwcli_resolve_child_hash(line->parent, line->tokenHash, text + line->tokenStart, len)
+                                        : lwcli_find_node_hash(line->parent, line->tokenHash, text + line->tokenStart, len);
+        if (hot != NULL && lwcli_command_visible(hot)) {
+            *cmd_end = line->parsedLen;
+            return hot;
         }
     }
+    *cmd_end = line->cmdEnd;
+    return (line->parent != 0) ? &lwcliObj.command_hot[line->parent - 1] : NULL;
 }
 
+#if (LWCLI_COMMAND_HIGHLIGHT == LWCLI_TRUE)
 /**
- * @brief 匹配命令（高效实现：手动解析 + 长度预检 + memcmp）
- * @param inputStr 输入字符串
- * @param expected_command 期望的命令字符串
- * @param expected_len 期望命令长度（避免 strlen）
- * @return 1 匹配成功
- * @return 0 匹配失败
+ * @brief 按增量解析结果为命令名着色
+ * @note 只在命令名的颜色或长度变化、或发生非追加编辑时重绘命令名；
+ *       行尾追加字符时只为新字符着色
  */
-static uint8_t lwcli_match_command(const char *inputStr, const char *expected_command, uint8_t expected_len)
+static void lwcli_highlight_update(void)
 {
-    uint8_t input_len = 0;
-    while (inputStr[input_len] && inputStr[input_len] != ' ' && input_len < LWCLI_COMMAND_STR_MAX_LENGTH) {
-        input_len++;
+    if (lwcli_input_pasting()) {
+        return;
     }
-    if (input_len == 0) {
-        return 0;
+    bool repaint = lwcliObj.line.dirty;
+    lwcli_line_sync();
+    const lwcli_line_t *line = &lwcliObj.line;
+    uint16_t len = 0;
+    uint8_t color = LWCLI_HIGHLIGHT_NONE;
+    if (line->firstEnd != 0) {
+        len = line->firstEnd;
+        color = (line->parent != 0) ? LWCLI_HIGHLIGHT_VALID : LWCLI_HIGHLIGHT_INVALID;
+    }
+    else if (line->inToken && line->tokenStart == 0) {
+        /* 命令名仍在输入中：以当前内容做一次查找 */
+        uint16_t cmd_end = 0;
+        len = line->parsedLen;
+        lwcli_input_gap_close();
+        command_hot_t *hot = lwcli_line_command(line, lwcliObj.inputBuffer, true, &cmd_end);
+        lwcli_input_gap_open();
+        color = (hot != NULL) ? LWCLI_HIGHLIGHT_VALID : LWCLI_HIGHLIGHT_INVALID;
+    }
+    uint16_t shown_len = lwcliObj.highlightLen;
+    bool same_color = (color == lwcliObj.highlightColor);
+    lwcliObj.highlightColor = color;
+    lwcliObj.highlightLen = len;
+    if (!repaint && same_color && len == shown_len) {
+        return;
     }
-    if (input_len != expected_len) {
-        return 0;
+    if (len == 0) {
+        return;     /* 命令名已被删除，屏幕上没有需要着色的字符 */
+    }
+    if (!repaint && same_color && len > shown_len && lwcliObj.cursorPos == len && lwcliObj.inputBufferPos == len) {
+        /* 行尾追加：只为新字符着色 */
+        lwcli_screen_move(len, shown_len);
+        lwcli_opt_output(ansi_highlight_color[color], (uint16_t)strlen(ansi_highlight_color[color]));
+        lwcli_input_output(shown_len, len);
+        lwcli_output_ansi(ansi_highlight_reset);
+        return;
+    }
+    lwcli_screen_move(lwcliObj.cursorPos, 0);
+    lwcli_opt_output(ansi_highlight_color[color], (uint16_t)strlen(ansi_highlight_color[color]));
+    lwcli_input_output(0, len);
+    lwcli_output_ansi(ansi_highlight_reset);
+    lwcli_screen_move(len, lwcliObj.cursorPos);
+}
+#endif  // LWCLI_COMMAND_HIGHLIGHT == LWCLI_TRUE
+
+#if (LWCLI_PARAMETER_SPLIT == LWCLI_TRUE)
+/**
+ * @brief 原地整理一个参数：去除双引号、处理反斜杠转义并以 '\0' 结尾
+ * @param arg 参数起始位置（位于输入缓冲区中）
+ * @param len 参数原始长度，arg[len] 为分隔空格或 '\0'
+ * @return 整理后的长度
+ */
+static uint16_t lwcli_argument_unquote(char *arg, uint16_t len)
+{
+    uint16_t out = 0;
+    bool escaped = false;
+    for (uint16_t i = 0; i < len; i++) {
+        char c = arg[i];
+        if (!escaped && (c == '\\' || c == '\"')) {
+            escaped = (c == '\\');
+            continue;
+        }
+        escaped = false;
+        arg[out++] = c;
     }
-    return memcmp(inputStr, expected_command, expected_len) == 0;
+    arg[out] = '\0';
+    return out;
 }
+#endif  // LWCLI_PARAMETER_SPLIT == LWCLI_TRUE
 
 /**
  * @brief 命令处理
+ * @note 参数分割模式下参数在 command 中原地分割，command 内容会被修改
  * @param command 命令字符串
+ * @param line command 的解析状态
  */
-static void lwcli_process_command(char *command)
+static void lwcli_process_command(char *command, const lwcli_line_t *line)
 {
-    command_t *cmd = NULL;
-    list_for_each_entry(cmd, &lwcliObj.command->node, node, command_t) {
-        if (lwcli_match_command(command, cmd->command, cmd->cmd_len)) {
+    uint16_t cmd_end = 0;
+    command_hot_t *cmd = lwcli_line_command(line, command, true, &cmd_end);
 #if (LWCLI_PARAMETER_SPLIT == LWCLI_TRUE)
-            char *cmdParameter = command;
-            uint8_t parameter_num = lwcli_get_parameter_number(cmdParameter);
-            if (parameter_num == 0) {
-                cmd->callback(0, NULL);
+    /* 参数：已确定的参数，或未能匹配为命令的最后一个 token */
+    uint16_t argc = line->argc;
+    uint16_t arg_start[1], arg_end[1];
+    const uint16_t *starts = line->argStart, *ends = line->argEnd;
+    if (cmd_end < line->parsedLen && line->inToken && !line->cmdDone) {
+        arg_start[0] = line->tokenStart;
+        arg_end[0] = line->parsedLen;
+        starts = arg_start;
+        ends = arg_end;
+        argc = 1;
+    }
+#endif  // LWCLI_PARAMETER_SPLIT == LWCLI_TRUE
+#if (LWCLI_COMMAND_ABBREVIATION == LWCLI_TRUE)
+    {
+        /* 已匹配部分之后的 token 是有歧义的缩写时，列出候选命令而不是作为参数 */
+        uint16_t start = cmd_end + lwcli_str_skip(command + cmd_end, line->parsedLen - cmd_end, ' ');
+        const char *token = command + start;
+        uint16_t len = lwcli_str_find(token, line->parsedLen - start, ' ');
+        if (lwcli_output_candidates((cmd != NULL) ? (uint16_t)(cmd - lwcliObj.command_hot) + 1 : 0, token, len)) {
+#if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
+            lwcli_output_file_path();
+#endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
+            return;
+        }
+    }
+#endif  // LWCLI_COMMAND_ABBREVIATION == LWCLI_TRUE
+    if (cmd != NULL && cmd->callback == NULL) {
+        /* 只输入了命令组，列出其子命令 */
+        lwcli_output_subcommands((uint16_t)(cmd - lwcliObj.command_hot) + 1);
 #if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
-                lwcli_output_file_path();
+        lwcli_output_file_path();
 #endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
-                return;
-            }
-            char **parameterArray = (char **)lwcli_dynamic_malloc(sizeof(char *) * parameter_num);
-            if (parameterArray == NULL) {
-                lwcli_printf("error malloc\r\n");
-                return;
-            }
-            uint8_t findParameterNum = lwcli_find_parameters(cmdParameter + cmd->cmd_len, parameterArray, parameter_num);
-            cmd->callback(findParameterNum, parameterArray);
-            lwcli_dynamic_free();  /* 释放 dynamic 池 */
+        return;
+    }
+    if (cmd != NULL) {
+#if (LWCLI_PARAMETER_SPLIT == LWCLI_TRUE)
+        char *argv[LWCLI_PARAMETER_MAX_NUM + 1];
+        uint16_t argl[LWCLI_PARAMETER_MAX_NUM];
+        if (line->inQuotes) {
+            argc = 0;   /* 引号未闭合则参数无效 */
+        }
+        for (uint16_t i = 0; i < argc; i++) {
+            uint16_t end = (ends[i] != 0) ? ends[i] : line->parsedLen;
+            argv[i] = command + starts[i];
+            argl[i] = lwcli_argument_unquote(argv[i], end - starts[i]);
+        }
+        argv[argc] = NULL;
+        lwcli_flush_before_callback();
+        cmd->callback(argc, argv, argl);
 #if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
+        if (!lwcli_raw_active()) {  /* 回调进入了原始模式时，退出后再显示提示符 */
             lwcli_output_file_path();
+        }
 #endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
-            return;
+        return;
 #else  // LWCLI_PARAMETER_SPLIT == LWCLI_TRUE
-            {
-                char *argvs = command + cmd->cmd_len;
-                while (*argvs == ' ') argvs++;
-                cmd->callback(argvs);
-            }
+        {
+            char *argvs = command + cmd_end;
+            while (*argvs == ' ') argvs++;
+            lwcli_flush_before_callback();
+            cmd->callback(argvs);
+        }
 #if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
+        if (!lwcli_raw_active()) {  /* 回调进入了原始模式时，退出后再显示提示符 */
             lwcli_output_file_path();
+        }
 #endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
-            return;
+        return;
 #endif  // LWCLI_PARAMETER_SPLIT == LWCLI_TRUE
-        }
     }
 
     lwcli_printf(lwcli_reminder, command);
@@ -717,135 +3266,222 @@ static void lwcli_process_command(char *command)
 #endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
 }
 
-#if (LWCLI_PARAMETER_SPLIT == LWCLI_TRUE)
+#if (LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE)
 /**
- * @brief 寻找参数总数量
- * @note 支持识别双引号
- * @param command_string 命令字符串
- * @return 参数数量
+ * @brief 计算两个字符串的公共前缀长度
+ * @param a 字符串 a
+ * @param b 字符串 b
+ * @return 公共前缀长度
  */
-static uint8_t lwcli_get_parameter_number(const char *command_string)
+static uint16_t lwcli_common_prefix_length(const char *a, const char *b)
 {
-    size_t len = strlen(command_string);
-    if (len <= 1) {
-        return 0;
-    }
-    bool in_quotes = false; // 是否处于引号中
-    uint8_t parameter_num = 0, quotes_num = 0;
-    for (uint8_t i = 0; i < len - 1; i++) {
-        if (command_string[i] == ' ' && command_string[i + 1] != ' ' && !in_quotes) {
-            parameter_num++;
-        }
-        else if (command_string[i] == '\"') {// 引号
-            quotes_num++;
-            in_quotes = !in_quotes;
-        }
-    }
-    if (command_string[len - 1] == '\"') {
-        quotes_num++;
-    }
-    parameter_num = (quotes_num % 2 == 0) ? parameter_num : 0; // 奇数个引号则参数无效
-    return parameter_num;
+    size_t len_a = strlen(a), len_b = strlen(b);
+    return lwcli_str_mismatch(a, b, (uint16_t)((len_a < len_b) ? len_a : len_b));
 }
+#endif  // LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE
 
 /**
- * @brief 提取参数放入字符串数组
- * @param argv_str 整个参数字符串
- * @param parameter_arry 字符串数组，存放提取出的参数
- * @return 找到的参数个数
+ * @brief 命令树节点排序比较：先按父节点，再按节点名的前 len 个字符
+ * @param hot 节点
+ * @param parent 父节点热数据下标 + 1
+ * @param str 节点名
+ * @param len 比较长度
+ * @return <0 / 0 / >0，节点名短于 len 且为 str 的前缀时视为更小
  */
-static uint8_t lwcli_find_parameters(const char *argv_str, char **parameter_arry, uint8_t parameter_num)
+static int lwcli_command_compare(const command_hot_t *hot, uint16_t parent, const char *str, uint16_t len)
 {
-    size_t len = strlen(argv_str);
-    if (len <= 1) {
-        return 0;
+    if (hot->parent != parent) {
+        return (hot->parent < parent) ? -1 : 1;
     }
-    uint8_t found_num = 0;
-    bool in_quotes = false; // 是否处于引号中
+    uint16_t offset = lwcli_command_name_offset(hot);
+    uint16_t name_len = hot->cmd_len - offset;
+    int ret = lwcli_name_compare(hot->desc->command + offset, str, (name_len < len) ? name_len : len);
+    return (ret == 0 && name_len < len) ? -1 : ret;
+}
 
-    uint8_t *index = (uint8_t*) lwcli_dynamic_malloc(sizeof(uint8_t) * (parameter_num + 1));  // 增加一个元素用于最后一个参数
-    if (index == NULL) {
-        lwcli_printf("error malloc\r\n");
-        return 0;
+/**
+ * @brief 按 (父节点, 节点名) 比较两个热数据下标
+ * @param a 热数据下标 a
+ * @param b 热数据下标 b
+ * @return <0 / 0 / >0
+ */
+static int lwcli_command_order(uint16_t a, uint16_t b)
+{
+    const command_hot_t *hot_a = &lwcliObj.command_hot[a];
+    const command_hot_t *hot_b = &lwcliObj.command_hot[b];
+    uint16_t offset = lwcli_command_name_offset(hot_b);
+    int ret = lwcli_command_compare(hot_a, hot_b->parent, hot_b->desc->command + offset, hot_b->cmd_len - offset);
+    return (ret != 0) ? ret : (int)hot_a->cmd_len - (int)hot_b->cmd_len;
+}
+
+/**
+ * @brief 把有序索引中 from 之后新追加的节点逐个插入有序位置
+ * @note 供单条注册使用，每次只追加命令路径上的少数节点，逐个二分查找位置后 memmove 后移
+ * @param from 新节点在有序索引中的起始位置
+ */
+static void lwcli_command_sort_insert(uint16_t from)
+{
+    for (uint16_t i = from; i < lwcliObj.command_num; i++) {
+        uint16_t index = lwcliObj.command_sorted[i];
+        uint16_t low = 0, high = i;
+        while (low < high) {
+            uint16_t mid = (low + high) / 2;
+            if (lwcli_command_order(lwcliObj.command_sorted[mid], index) <= 0) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        memmove(&lwcliObj.command_sorted[low + 1], &lwcliObj.command_sorted[low], sizeof(uint16_t) * (i - low));
+        lwcliObj.command_sorted[low] = index;
     }
+}
 
-    // 找到参数位置
-    for (uint8_t i = 0; i < len - 1; i++) {
-        if (argv_str[i] == ' ' && argv_str[i + 1] != ' ' && !in_quotes) {
-            index[found_num++] = i + 1;
-            if (found_num == parameter_num)
-                break;
+/**
+ * @brief 有序索引堆排序的下沉操作
+ * @param root 下沉起点
+ * @param end 堆的元素个数
+ */
+static void lwcli_command_sift_down(uint16_t root, uint16_t end)
+{
+    uint16_t *sorted = lwcliObj.command_sorted;
+    uint16_t index = sorted[root];
+    uint32_t child;
+    while ((child = 2 * (uint32_t)root + 1) < end) {
+        if (child + 1 < end && lwcli_command_order(sorted[child], sorted[child + 1]) < 0) {
+            child++;
         }
-        else if (argv_str[i] == '\"') {
-            in_quotes = !in_quotes;
+        if (lwcli_command_order(index, sorted[child]) >= 0) {
+            break;
         }
+        sorted[root] = sorted[child];
+        root = (uint16_t)child;
     }
+    sorted[root] = index;
+}
 
-    // 提取处理参数
-    for (uint8_t i = 0; i < found_num; i++) {
-        uint8_t start = index[i];
-        uint8_t end = 0;
-        end = (i + 1 < found_num) ? index[i + 1] - 1: len;  // 确保最后一个参数处理正确
-        uint8_t param_len = end - start;
+/**
+ * @brief 对整个有序索引原地堆排序
+ * @note 供命令表与导出段整表注册使用，O(n log n)，不依赖 libc qsort 且无额外内存，
+ *       避免逐条插入的 O(n * m) 搬移；Tab 与分发路径从不排序
+ */
+static void lwcli_command_sort(void)
+{
+    uint16_t *sorted = lwcliObj.command_sorted;
+    for (uint16_t i = lwcliObj.command_num / 2; i > 0; i--) {
+        lwcli_command_sift_down(i - 1, lwcliObj.command_num);
+    }
+    for (uint16_t end = lwcliObj.command_num; end > 1; end--) {
+        uint16_t top = sorted[0];
+        sorted[0] = sorted[end - 1];
+        sorted[end - 1] = top;
+        lwcli_command_sift_down(0, end - 1);
+    }
+}
 
-        parameter_arry[i] = (char *)lwcli_dynamic_malloc(param_len + 1);
-        if (parameter_arry[i] == NULL) {
-            return 0;  /* 由调用方 lwcli_process_command 的 lwcli_dynamic_free 统一释放 */
+/**
+ * @brief 在有序命令索引中查找某个节点下以 prefix 开头的子命令区间
+ * @note 有序数组中同层、同前缀的命令连续存放，两次二分查找即可得到区间
+ * @param parent 父节点热数据下标 + 1，0 为根
+ * @param prefix 前缀
+ * @param prefix_len 前缀长度，0 表示全部子命令
+ * @param first 输出：区间起始位置（command_sorted 下标）
+ * @return 匹配的命令数量
+ */
+static uint16_t lwcli_command_prefix_range(uint16_t parent, const char *prefix, uint16_t prefix_len, uint16_t *first)
+{
+    uint16_t low = 0, high = lwcliObj.command_num;
+    while (low < high) {    /* 第一个 >= prefix 的位置 */
+        uint16_t mid = (low + high) / 2;
+        if (lwcli_command_compare(&lwcliObj.command_hot[lwcliObj.command_sorted[mid]], parent, prefix, prefix_len) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    *first = low;
+    high = lwcliObj.command_num;
+    while (low < high) {    /* 第一个前缀 > prefix 的位置 */
+        uint16_t mid = (low + high) / 2;
+        if (lwcli_command_compare(&lwcliObj.command_hot[lwcliObj.command_sorted[mid]], parent, prefix, prefix_len) <= 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
-        memcpy(parameter_arry[i], argv_str + start, param_len);
-        parameter_arry[i][param_len] = '\0';  // 添加字符串结束符 避免乱码
     }
-    // 此处不能释放 index 内存，因为参数可能被用户回调函数使用
-    return found_num;
+    return low - *first;
 }
-#endif  // LWCLI_PARAMETER_SPLIT == LWCLI_TRUE
 
 /**
- * @brief 计算最大补全长度
- * @param argc 匹配的命令数量
- * @param argv 匹配的命令
- * @return 最大补全长度
+ * @brief 去掉有序命令区间首尾未挂载的命令
+ * @param first 输入输出：区间起始位置
+ * @param num 输入输出：区间元素个数
+ * @return 区间中已挂载命令的数量
  */
-int lwcli_longest_common_prefix_length(int argc, char *argv[])
+static uint16_t lwcli_command_visible_range(uint16_t *first, uint16_t *num)
 {
-    if (argc <= 0 || !argv) return 0;
-    if (argc == 1) return argv[0] ? strlen(argv[0]) : 0;
-
-    const char *base = argv[0];
-    size_t len = 0;
-
-    while (*base) { // 只要基准字符串没结束
-        for (int i = 1; i < argc; i++) {
-            if (!argv[i][len] || argv[i][len] != *base) {
-                return (int)len;
-            }
-        }
-        len++;
-        base++;
+    uint16_t end = *first + *num;
+    uint16_t visible_num = 0;
+    while (*first < end && !lwcli_command_visible(&lwcliObj.command_hot[lwcliObj.command_sorted[*first]])) {
+        (*first)++;
+    }
+    while (end > *first && !lwcli_command_visible(&lwcliObj.command_hot[lwcliObj.command_sorted[end - 1]])) {
+        end--;
     }
+    *num = end - *first;
+    for (uint16_t i = *first; i < end; i++) {
+        visible_num += lwcli_command_visible(&lwcliObj.command_hot[lwcliObj.command_sorted[i]]);
+    }
+    return visible_num;
+}
 
-    // 走到这里说明 base 字符串是所有字符串的前缀
-    return (int)len;
+/**
+ * @brief 把 start 开始的 token 替换为唯一的补全结果并追加空格，光标移到行尾
+ * @note 调用时间隙已合并；屏幕上只重绘与原 token 不同的部分
+ * @param start token 在 inputBuffer 中的起始下标
+ * @param name 补全结果
+ * @param len 补全结果长度
+ */
+static void lwcli_input_complete(uint16_t start, const char *name, uint16_t len)
+{
+    uint16_t screen_cursor = lwcliObj.cursorPos;
+    uint16_t screen_len = lwcliObj.inputBufferPos;
+    uint16_t from = 0;
+    while (from < len && start + from < screen_len && lwcliObj.inputBuffer[start + from] == name[from]) {
+        from++;
+    }
+    from += start;
+    if (from == start + len && from < screen_len && lwcliObj.inputBuffer[from] == ' ') {
+        from++;     /* 原 token 之后已是空格 */
+    }
+    memcpy(lwcliObj.inputBuffer + start, name, len);
+    lwcliObj.inputBufferPos = start + len;
+    lwcliObj.inputBuffer[lwcliObj.inputBufferPos++] = ' ';
+    lwcliObj.inputBuffer[lwcliObj.inputBufferPos] = '\0';
+    lwcliObj.cursorPos = lwcliObj.inputBufferPos;
+    lwcli_line_update(screen_cursor, screen_len, from);
 }
 
 /**
  * @brief 补全命令
+ * @note 只在 parent 的子命令中查找，输入中 token_start 之后为待补全的 token
+ * @param parent 父节点热数据下标 + 1，0 为根
+ * @param token_start 待补全 token 在 inputBuffer 中的起始下标
  */
-static void lwcli_fix_command(void)
+static void lwcli_fix_command(uint16_t parent, uint16_t token_start)
 {
-    const char *prefix = lwcliObj.inputBuffer;
-    command_t *cmd = NULL;
-    uint16_t match_num = 0;
+    const command_hot_t *cmd = NULL;
+    uint16_t first = 0;
     if (!lwcliObj.inputBufferPos) {
         return;
     }
-    list_for_each_entry(cmd, &lwcliObj.command->node, node, command_t) {
-        if (lwcliObj.inputBufferPos < cmd->cmd_len) {
-            if (memcmp(cmd->command, prefix, lwcliObj.inputBufferPos) == 0) {
-                match_num++;
-            }
-        }
+    uint16_t prefix_len = lwcliObj.inputBufferPos - token_start;
+    uint16_t range_num = lwcli_command_prefix_range(parent, lwcliObj.inputBuffer + token_start, prefix_len, &first);
+    if (range_num > 0 && lwcliObj.command_hot[lwcliObj.command_sorted[first]].cmd_len - lwcli_command_name_offset(&lwcliObj.command_hot[lwcliObj.command_sorted[first]]) == prefix_len) {
+        first++;    /* 与输入完全相同的命令排在区间首位，不参与补全 */
+        range_num--;
     }
+    uint16_t match_num = lwcli_command_visible_range(&first, &range_num);
 
     if (match_num == 0) {
         #if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
@@ -854,54 +3490,48 @@ static void lwcli_fix_command(void)
         lwcliObj.cursorPos = lwcliObj.inputBufferPos;
         lwcli_opt_output(lwcliObj.inputBuffer, lwcliObj.inputBufferPos);
         #else
-        uint16_t output_len = snprintf(lwcliObj.ouputBuffer, sizeof(lwcliObj.ouputBuffer), "\r\n\r\n%s", lwcliObj.inputBuffer);
-        lwcli_opt_output(lwcliObj.ouputBuffer, output_len);
+        lwcli_printf("\r\n\r\n%s", lwcliObj.inputBuffer);
         #endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
     }
     else if (match_num == 1) {
-        list_for_each_entry(cmd, &lwcliObj.command->node, node, command_t) {
-            if (lwcliObj.inputBufferPos < cmd->cmd_len) {
-                if (memcmp(cmd->command, prefix, lwcliObj.inputBufferPos) == 0) {
-                    memcpy(lwcliObj.inputBuffer, cmd->command, cmd->cmd_len);
-                    lwcliObj.inputBufferPos = cmd->cmd_len;
-                    lwcliObj.inputBuffer[lwcliObj.inputBufferPos++] = ' ';
-                    lwcliObj.cursorPos = lwcliObj.inputBufferPos;
-                    lwcli_opt_output(ansi_clear_line, sizeof(ansi_clear_line));
-#if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
-                    lwcli_output_file_path();
-#endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
-                    lwcli_opt_output(lwcliObj.inputBuffer, lwcliObj.inputBufferPos);
-                    break;
-                }
-            }
+        cmd = &lwcliObj.command_hot[lwcliObj.command_sorted[first]];
+        uint16_t offset = lwcli_command_name_offset(cmd);
+        uint16_t name_len = cmd->cmd_len - offset;
+        /* 确保补全后加空格不越界 */
+        if ((size_t)token_start + name_len + 1 >= sizeof(lwcliObj.inputBuffer)) {
+            return;
         }
+        lwcli_input_complete(token_start, cmd->desc->command + offset, name_len);
     }
     else {
-        char **match_arr = NULL;
-        uint16_t match_index = 0;
-        match_arr = (char **)lwcli_dynamic_malloc(sizeof(char *) * match_num);
-        if (match_arr == NULL) {
-            return;
+        /* 有序区间的公共前缀即首尾两项的公共前缀 */
+        const command_hot_t *first_cmd = &lwcliObj.command_hot[lwcliObj.command_sorted[first]];
+        const command_hot_t *last_cmd = &lwcliObj.command_hot[lwcliObj.command_sorted[first + range_num - 1]];
+        uint16_t offset = lwcli_command_name_offset(first_cmd);
+        const char *first_name = first_cmd->desc->command + offset;
+        const char *last_name = last_cmd->desc->command + offset;
+        uint16_t name_len = first_cmd->cmd_len - offset;     /* 中间节点的名称之后不是 '\0' */
+        if (name_len > last_cmd->cmd_len - offset) {
+            name_len = last_cmd->cmd_len - offset;
         }
-
-        list_for_each_entry(cmd, &lwcliObj.command->node, node, command_t) {
-            if (lwcliObj.inputBufferPos < cmd->cmd_len &&
-                memcmp(cmd->command, prefix, lwcliObj.inputBufferPos) == 0) {
-                match_arr[match_index++] = cmd->command;
-            }
+        uint16_t match_max_len = 0;
+        while (match_max_len < name_len && LWCLI_CASE_FOLD(first_name[match_max_len]) == LWCLI_CASE_FOLD(last_name[match_max_len])) {
+            match_max_len++;
         }
-
-        uint16_t match_max_len = lwcli_longest_common_prefix_length(match_num, match_arr);
         lwcli_opt_output("\r\n", 2);
-        for (uint16_t i = 0; i < match_num; i++) {
-            lwcli_opt_output(match_arr[i], strlen(match_arr[i]));
-            lwcli_opt_output("    ", 4);
+        for (uint16_t i = first; i < first + range_num; i++) {
+            cmd = &lwcliObj.command_hot[lwcliObj.command_sorted[i]];
+            if (lwcli_command_visible(cmd)) {
+                lwcli_opt_output(cmd->desc->command + offset, cmd->cmd_len - offset);
+                lwcli_opt_output("    ", 4);
+            }
         }
-        
-        while (lwcliObj.inputBufferPos < match_max_len) {
-            lwcliObj.inputBuffer[lwcliObj.inputBufferPos] = match_arr[0][lwcliObj.inputBufferPos];
-            lwcliObj.inputBufferPos++;
+
+        while (prefix_len < match_max_len &&
+               lwcliObj.inputBufferPos < (uint16_t)(sizeof(lwcliObj.inputBuffer) - 1)) {
+            lwcliObj.inputBuffer[lwcliObj.inputBufferPos++] = first_name[prefix_len++];
         }
+        lwcliObj.inputBuffer[lwcliObj.inputBufferPos] = '\0';
         lwcliObj.cursorPos = lwcliObj.inputBufferPos;
 
         #if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
@@ -909,11 +3539,8 @@ static void lwcli_fix_command(void)
         lwcli_output_file_path();
         lwcli_opt_output(lwcliObj.inputBuffer, lwcliObj.inputBufferPos);
         #else
-        uint16_t output_len = snprintf(lwcliObj.ouputBuffer, sizeof(lwcliObj.ouputBuffer), "\r\n\r\n%s", lwcliObj.inputBuffer);
-        lwcli_opt_output(lwcliObj.ouputBuffer, output_len);
+        lwcli_printf("\r\n\r\n%s", lwcliObj.inputBuffer);
         #endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
-
-        lwcli_dynamic_free();
     }
 }
 
@@ -921,112 +3548,150 @@ static void lwcli_fix_command(void)
 /**
  * @brief 获取当前光标位置所在“参数token”的前缀
  * @details
+ *  - 直接使用增量解析状态，无需重新扫描参数部分
  *  - 支持双引号包裹：token 内部的空格不参与分隔
  *  - 支持多个参数：只匹配“最后一个token”的前缀
  *  - 若光标位于token后的空格处，则当前前缀视为长度为0
  *
- * @param cmd 参数所属的命令
+ * @param line 输入行的解析状态
+ * @param cmd_end 命令部分（含子命令）在 inputBuffer 中的结束下标
  * @param prefix 输出：指向当前token前缀起始地址
  * @param prefix_len 输出：当前token前缀长度（不含分隔空格；尾随空格场景为0）
  * @param prefix_start_pos 输出：token在 inputBuffer 中的起始下标
+ * @param position 输出：当前token是第几个参数（从 1 开始）
  */
-static void lwcli_get_current_parameter_prefix(command_t *cmd, const char **prefix, int *prefix_len, uint16_t *prefix_start_pos)
+static void lwcli_get_current_parameter_prefix(const lwcli_line_t *line, uint16_t cmd_end, const char **prefix, int *prefix_len, uint16_t *prefix_start_pos, uint8_t *position)
 {
     const char *buf = lwcliObj.inputBuffer;
-    uint16_t cursor = lwcliObj.inputBufferPos;
-    uint8_t cmd_end = (size_t)cmd->cmd_len;
+    uint16_t cursor = line->parsedLen;
 
-    /* 保持与原实现一致：cmd后无字符时 prefix_len 为负，后续逻辑会走 prefix_len < 0 分支补空格 */
+    /* cmd后无字符时 prefix_len 为负，后续逻辑会走 prefix_len < 0 分支补空格 */
     if (cursor <= cmd_end) {
         *prefix_start_pos = cmd_end + 1;
         *prefix = buf + cmd_end + 1;
         *prefix_len = (int)cursor - (int)cmd_end - 1;
+        *position = 1;
         return;
     }
 
-    /* 1) 判断光标处是否仍在引号中；若不在引号中且末尾有空格，则当前token前缀为空 */
-    bool in_quotes = false;
-    for (uint16_t i = cmd_end; i < cursor; i++) {
-        if (buf[i] == '\"') {
-            in_quotes = !in_quotes;
-        }
-    }
-    if (!in_quotes) {
-        uint16_t end = cursor;
-        while (end > cmd_end && buf[end - 1] == ' ') {
-            end--;
-        }
-        if (end < cursor) {
-            *prefix_start_pos = cursor;
-            *prefix = buf + cursor;
-            *prefix_len = 0;
-            return;
-        }
-    }
-
-    /* 2) 跳过命令后的前导空格，找到token起点 */
-    uint16_t start = cmd_end;
-    while (start < cursor && buf[start] == ' ') {
-        start++;
-    }
-    if (start >= cursor) {
+    /* cmd_end 之后的 token 均为参数：已确定的参数，加上未能匹配为子命令的最后一个 token */
+    uint16_t token_num = line->argc + ((line->inToken && !line->cmdDone) ? 1 : 0);
+    if (!line->inToken) {
         *prefix_start_pos = cursor;
         *prefix = buf + cursor;
         *prefix_len = 0;
+        *position = (uint8_t)(token_num + 1);
         return;
     }
+    *prefix_start_pos = line->tokenStart;
+    *prefix = buf + line->tokenStart;
+    *prefix_len = (int)(cursor - line->tokenStart);
+    *position = (uint8_t)token_num;
+}
+
+/**
+ * @brief 参数排序比较：先按适用位置，再按参数字符串的前 len 个字符
+ * @param param 参数
+ * @param position 位置
+ * @param str 字符串
+ * @param len 比较长度
+ * @return <0 / 0 / >0
+ */
+static int lwcli_parameter_compare(const lwcli_parameter_t *param, uint8_t position, const char *str, size_t len)
+{
+    if (param->position != position) {
+        return (param->position < position) ? -1 : 1;
+    }
+    return strncmp(param->parameter, str, len);
+}
 
-    /* 3) 扫描分隔位置：空格且不在引号中，且后一个不是空格 */
-    uint16_t token_start = start;
-    in_quotes = false;
-    for (uint16_t i = start; i < cursor; i++) {
-        char c = buf[i];
-        if (c == '\"') {
-            in_quotes = !in_quotes;
+/**
+ * @brief 在有序参数表中查找适用于 position 且以 prefix 开头的参数区间
+ * @param cmd 命令描述符
+ * @param position 参数位置，0 为任意位置
+ * @param prefix 前缀
+ * @param prefix_len 前缀长度
+ * @param first 输出：区间起始下标
+ * @return 匹配的参数数量
+ */
+static uint16_t lwcli_parameter_prefix_range(const lwcli_command_t *cmd, uint8_t position, const char *prefix, uint16_t prefix_len, uint16_t *first)
+{
+    uint16_t low = 0, high = cmd->parameter_num;
+    while (low < high) {
+        uint16_t mid = (low + high) / 2;
+        if (lwcli_parameter_compare(&cmd->parameters[mid], position, prefix, prefix_len) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
-        if (!in_quotes && c == ' ' && (i + 1) < cursor && buf[i + 1] != ' ') {
-            token_start = i + 1;
+    }
+    *first = low;
+    high = cmd->parameter_num;
+    while (low < high) {
+        uint16_t mid = (low + high) / 2;
+        if (lwcli_parameter_compare(&cmd->parameters[mid], position, prefix, prefix_len) <= 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
     }
+    return low - *first;
+}
 
-    *prefix_start_pos = token_start;
-    *prefix = buf + token_start;
-    *prefix_len = (int)(cursor - token_start);
+/**
+ * @brief 按字符串顺序合并输出两个有序参数区间
+ * @param cmd 命令描述符
+ * @param first 两个区间的起始下标
+ * @param num 两个区间的元素个数
+ */
+static void lwcli_parameter_output_range(const lwcli_command_t *cmd, const uint16_t first[2], const uint16_t num[2])
+{
+    uint16_t i = first[0], j = first[1];
+    uint16_t end_i = first[0] + num[0], end_j = first[1] + num[1];
+    while (i < end_i || j < end_j) {
+        const char *str = NULL;
+        if (j >= end_j || (i < end_i && strcmp(cmd->parameters[i].parameter, cmd->parameters[j].parameter) <= 0)) {
+            str = cmd->parameters[i++].parameter;
+        } else {
+            str = cmd->parameters[j++].parameter;
+        }
+        lwcli_opt_output(str, strlen(str));
+        lwcli_opt_output("    ", 4);
+    }
 }
 
 /**
  * @brief 补全参数
- * @param cmd 参数所属的命令
+ * @note 候选项为适用于当前参数位置的参数与任意位置参数两个有序区间，
+ *       区间由二分查找得到，公共前缀由区间的最小、最大字符串求得
+ * @param hot 参数所属的命令
+ * @param cmd_end 命令部分（含子命令）在 inputBuffer 中的结束下标
  */
-static void lwcli_fix_parameter(command_t *cmd)
+static void lwcli_fix_parameter(const command_hot_t *hot, uint16_t cmd_end)
 {
-    if (list_empty(&cmd->para.node)) {
+    const lwcli_command_t *cmd = hot->desc;
+    if (cmd->parameter_num == 0) {
         return;
     }
     const char *prefix = NULL;
     int prefix_len = 0;
     uint16_t prefix_start_pos = 0;
-    lwcli_get_current_parameter_prefix(cmd, &prefix, &prefix_len, &prefix_start_pos);
-    uint16_t match_num = 0;
-    parameter_t *param = NULL;
+    uint8_t position = 0;
+    lwcli_get_current_parameter_prefix(&lwcliObj.line, cmd_end, &prefix, &prefix_len, &prefix_start_pos, &position);
     if (!lwcliObj.inputBufferPos) {
         return;
     }
-    list_for_each_entry(param, &cmd->para.node, node, parameter_t) {
-        if (prefix_len > 0 && (uint16_t)prefix_len <= param->len) {
-            if (memcmp(param->data, prefix, (uint16_t)prefix_len) == 0) {
-                match_num++;
-            }
-        }
-    }
+    uint16_t first[2] = {0}, num[2] = {0};
+    uint16_t search_len = (prefix_len > 0) ? (uint16_t)prefix_len : 0;
+    num[0] = lwcli_parameter_prefix_range(cmd, position, prefix, search_len, &first[0]);
+    num[1] = lwcli_parameter_prefix_range(cmd, 0, prefix, search_len, &first[1]);
+    uint16_t match_num = (prefix_len > 0) ? (num[0] + num[1]) : 0;
 
     if (match_num == 0) {
         lwcli_opt_output("\r\n", 2);
         if (prefix_len == 0) {
-            /* 用户仅输入 "cmd " 未输入前缀时，列出所有参数 */
-            list_for_each_entry(param, &cmd->para.node, node, parameter_t) {
-                lwcli_printf("%s    ", param->data);
-            }
+            /* 用户仅输入 "cmd " 未输入前缀时，列出当前位置的所有参数 */
+            lwcli_parameter_output_range(cmd, first, num);
         }
         #if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
         lwcli_opt_output("\r\n", 2);
@@ -1046,49 +3711,37 @@ static void lwcli_fix_parameter(command_t *cmd)
         #endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
     }
     else if (match_num == 1) {
-        list_for_each_entry(param, &cmd->para.node, node, parameter_t) {
-            if ((size_t)prefix_len <= param->len && memcmp(param->data, prefix, (size_t)prefix_len) == 0) {
-                /* 确保补全后加空格不越界 */
-                if (prefix_start_pos + param->len + 1 >= sizeof(lwcliObj.inputBuffer)) {
-                    break;
-                }
-                memcpy(lwcliObj.inputBuffer + prefix_start_pos, param->data, param->len);
-                lwcliObj.inputBufferPos = prefix_start_pos + param->len;
-                lwcliObj.inputBuffer[lwcliObj.inputBufferPos++] = ' ';
-                lwcliObj.cursorPos = lwcliObj.inputBufferPos;
-                lwcli_opt_output(ansi_clear_line, sizeof(ansi_clear_line));
-#if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
-                lwcli_output_file_path();
-#endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
-                lwcli_opt_output(lwcliObj.inputBuffer, lwcliObj.inputBufferPos);
-                break;
-            }
+        const lwcli_parameter_t *param = &cmd->parameters[num[0] ? first[0] : first[1]];
+        size_t param_len = strlen(param->parameter);
+        /* 确保补全后加空格不越界 */
+        if (prefix_start_pos + param_len + 1 >= sizeof(lwcliObj.inputBuffer)) {
+            return;
         }
+        lwcli_input_complete(prefix_start_pos, param->parameter, (uint16_t)param_len);
     }
     else {
-        char **match_arr = NULL;
-        uint16_t match_index = 0;
-        match_arr = (char **)lwcli_dynamic_malloc(sizeof(char *) * match_num);
-        if (match_arr == NULL) {
-            return;
-        }
-
-        list_for_each_entry(param, &cmd->para.node, node, parameter_t) {
-            if ((size_t)prefix_len <= param->len && memcmp(param->data, prefix, (size_t)prefix_len) == 0) {
-                match_arr[match_index++] = param->data;
+        /* 两个有序区间并集的公共前缀 = 最小字符串与最大字符串的公共前缀 */
+        const char *min_str = NULL, *max_str = NULL;
+        for (uint8_t k = 0; k < 2; k++) {
+            if (num[k] == 0) {
+                continue;
+            }
+            const char *low_str = cmd->parameters[first[k]].parameter;
+            const char *high_str = cmd->parameters[first[k] + num[k] - 1].parameter;
+            if (min_str == NULL || strcmp(low_str, min_str) < 0) {
+                min_str = low_str;
+            }
+            if (max_str == NULL || strcmp(high_str, max_str) > 0) {
+                max_str = high_str;
             }
         }
-
-        uint16_t match_max_len = lwcli_longest_common_prefix_length(match_num, match_arr);
+        uint16_t match_max_len = lwcli_common_prefix_length(min_str, max_str);
         lwcli_opt_output("\r\n", 2);
-        for (uint16_t i = 0; i < match_num; i++) {
-            lwcli_opt_output(match_arr[i], strlen(match_arr[i]));
-            lwcli_opt_output("    ", 4);
-        }
-        
+        lwcli_parameter_output_range(cmd, first, num);
+
         while (prefix_len < match_max_len &&
                lwcliObj.inputBufferPos < (uint16_t)(sizeof(lwcliObj.inputBuffer) - 1)) {
-            lwcliObj.inputBuffer[lwcliObj.inputBufferPos++] = match_arr[0][prefix_len++];
+            lwcliObj.inputBuffer[lwcliObj.inputBufferPos++] = min_str[prefix_len++];
         }
         lwcliObj.cursorPos = lwcliObj.inputBufferPos;
 
@@ -1097,44 +3750,63 @@ static void lwcli_fix_parameter(command_t *cmd)
         lwcli_output_file_path();
         lwcli_opt_output(lwcliObj.inputBuffer, lwcliObj.inputBufferPos);
         #else
-        uint16_t output_len = snprintf(lwcliObj.ouputBuffer, sizeof(lwcliObj.ouputBuffer), "\r\n\r\n%s", lwcliObj.inputBuffer);
-        lwcli_opt_output(lwcliObj.ouputBuffer, output_len);
+        lwcli_printf("\r\n\r\n%s", lwcliObj.inputBuffer);
         #endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
-
-        lwcli_dynamic_free();
     }
 }
 #endif  // LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE
 
 /**
  * @brief tab 补全处理
+ * @note 沿命令树匹配已输入的命令部分；最后一个 token 若能补全为子命令则补全子命令，否则补全参数。
+ *       help 的参数为命令路径，直接在命令树中继续补全
  */
 static void lwcli_table_process(void)
 {
-    if (lwcliObj.command == NULL) {
+    if (!lwcliObj.initialized) {
         return;
     }
-    command_t *cmd = NULL;
-    bool compelter_par = false;
     if (!lwcliObj.inputBufferPos) {
         return;
     }
-#if (LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE)
-    list_for_each_entry(cmd, &lwcliObj.command->node, node, command_t) {
-        if (lwcli_match_command(lwcliObj.inputBuffer, cmd->command, cmd->cmd_len)) {
-            compelter_par = true;
-            break;
+    char *buf = lwcliObj.inputBuffer;
+    uint16_t cmd_end = 0;
+    command_hot_t *hot = lwcli_line_command(&lwcliObj.line, buf, false, &cmd_end);
+    bool help_path = (hot != NULL && hot->callback == lwcli_help);
+    if (help_path) {
+        uint16_t path_start = cmd_end + lwcli_str_skip(buf + cmd_end, lwcliObj.inputBufferPos - cmd_end, ' '), path_end = 0;
+        hot = lwcli_find_command(buf + path_start, &path_end, false);
+        if (hot != NULL) {
+            cmd_end = path_start + path_end;
+        }
+    }
+    uint16_t parent = (hot != NULL) ? (uint16_t)(hot - lwcliObj.command_hot) + 1 : 0;
+    uint16_t token_start = cmd_end + lwcli_str_skip(buf + cmd_end, lwcliObj.inputBufferPos - cmd_end, ' ');
+    uint16_t token_len = lwcliObj.inputBufferPos - token_start;
+    uint16_t first = 0;
+    uint16_t range_num = (lwcli_str_find(buf + token_start, token_len, ' ') == token_len)
+                       ? lwcli_command_prefix_range(parent, buf + token_start, token_len, &first) : 0;
+
+    if (lwcli_command_visible_range(&first, &range_num) > 0) {
+        /* 命令名后直接按 Tab 时先补一个空格，再列出子命令 */
+        if (token_start == lwcliObj.inputBufferPos && buf[token_start - 1] != ' ') {
+            if (lwcliObj.inputBufferPos >= (uint16_t)(sizeof(lwcliObj.inputBuffer) - 1)) {
+                return;
+            }
+            buf[lwcliObj.inputBufferPos++] = ' ';
+            buf[lwcliObj.inputBufferPos] = '\0';
+            token_start = lwcliObj.inputBufferPos;
         }
+        lwcli_fix_command(parent, token_start);
     }
-    if (compelter_par) {
-        lwcli_fix_parameter(cmd);
+#if (LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE)
+    else if (hot != NULL && !help_path) {
+        lwcli_fix_parameter(hot, cmd_end);
     }
+#endif  // LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE
     else {
-        lwcli_fix_command();
+        lwcli_fix_command(parent, token_start);
     }
-#else
-    lwcli_fix_command();
-#endif  // LWCLI_PARAMETER_COMPLETION == LWCLI_TRUE
 }
 
 #if (LWCLI_HISTORY_COMMAND_NUM > 0)
@@ -1162,14 +3834,16 @@ static bool lwcli_history_is_empty()
 
 /**
  * @brief 添加一条历史命令
+ * @param command 命令字符串
+ * @param len 命令长度
  */
-static void lwcli_add_history_command(void)
+static void lwcli_add_history_command(const char *command, uint16_t len)
 {
     if (lwcli_history_is_full()) {
         HISTORY_UPDATE_READ_INDEX();
     }
-    memcpy(lwcliObj.historyList.buffer + (lwcliObj.historyList.writePos * lwcliObj.historyList.commandStrSize), lwcliObj.inputBuffer, lwcliObj.inputBufferPos);
-    lwcliObj.historyList.buffer[lwcliObj.historyList.writePos * lwcliObj.historyList.commandStrSize + lwcliObj.inputBufferPos] = '\0';
+    memcpy(lwcliObj.historyList.buffer + (lwcliObj.historyList.writePos * lwcliObj.historyList.commandStrSize), command, len);
+    lwcliObj.historyList.buffer[lwcliObj.historyList.writePos * lwcliObj.historyList.commandStrSize + len] = '\0';
     HISTORY_UPDATE_WRITE_INDEX();
     lwcliObj.historyList.findPos = lwcliObj.historyList.writePos;
 
@@ -1197,6 +3871,7 @@ static void lwcli_add_history_command(void)
  */
 static void lwcli_history_command_up(void)
 {
+    lwcliObj.line.dirty = true;
     uint16_t historyCmdPos = lwcliObj.historyList.findPosIndex[0]; 
 
     if (lwcli_history_is_empty()) {
@@ -1208,22 +3883,13 @@ static void lwcli_history_command_up(void)
         historyCmdPos = lwcliObj.historyList.findPosIndex[lwcliObj.historyList.findPos];
     }
 
-    uint8_t historyCommandLen = 0;
+    uint16_t historyCommandLen = 0;
     char cmdChar = lwcliObj.historyList.buffer[historyCmdPos * lwcliObj.historyList.commandStrSize];
     while (cmdChar != '\0' && historyCommandLen < lwcliObj.historyList.commandStrSize) {
         historyCommandLen++;
         cmdChar = lwcliObj.historyList.buffer[historyCmdPos * lwcliObj.historyList.commandStrSize + historyCommandLen];
     }
-    memcpy(lwcliObj.inputBuffer, lwcliObj.historyList.buffer + (historyCmdPos * lwcliObj.historyList.commandStrSize), lwcliObj.historyList.commandStrSize);
-    lwcliObj.inputBuffer[historyCommandLen] = '\0';
-    lwcliObj.inputBufferPos = historyCommandLen;
-
-    lwcli_opt_output(ansi_clear_line, sizeof(ansi_clear_line));
-    #if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
-    lwcli_output_file_path();
-    #endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
-    lwcli_opt_output(lwcliObj.inputBuffer, lwcliObj.inputBufferPos);
-    lwcliObj.cursorPos = lwcliObj.inputBufferPos;
+    lwcli_input_replace(lwcliObj.historyList.buffer + (historyCmdPos * lwcliObj.historyList.commandStrSize), historyCommandLen);
 }
 
 /**
@@ -1231,6 +3897,7 @@ static void lwcli_history_command_up(void)
  */
 static void lwcli_history_command_down(void)
 {
+    lwcliObj.line.dirty = true;
     uint16_t historyCmdPos = lwcliObj.historyList.findPosIndex[0]; 
 
     if (lwcli_history_is_empty()) {
@@ -1239,13 +3906,7 @@ static void lwcli_history_command_down(void)
 
     if (lwcli_history_is_full()) {
         if (lwcliObj.historyList.findPos >= LWCLI_HISTORY_COMMAND_NUM - 1) { // 还没有使用UP键，则不允许使用Down 或者 Down到最后一个了
-            lwcli_opt_output(ansi_clear_line, sizeof(ansi_clear_line));
-            #if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
-            lwcli_output_file_path();
-            #endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
-            lwcliObj.inputBuffer[0] = '\0';
-            lwcliObj.inputBufferPos = 0;
-            lwcliObj.cursorPos = 0;
+            lwcli_input_replace("", 0);
             return;
         }
         else {
@@ -1257,13 +3918,7 @@ static void lwcli_history_command_down(void)
     }
     else {
         if (lwcliObj.historyList.findPos >= lwcliObj.historyList.writePos){  // 处于当前输入位置，Down 应清空
-            lwcli_opt_output(ansi_clear_line, sizeof(ansi_clear_line));
-            #if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
-            lwcli_output_file_path();
-            #endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
-            lwcliObj.inputBuffer[0] = '\0';
-            lwcliObj.inputBufferPos = 0;
-            lwcliObj.cursorPos = 0;
+            lwcli_input_replace("", 0);
             return;
         }
         else {
@@ -1273,26 +3928,17 @@ static void lwcli_history_command_down(void)
             historyCmdPos = lwcliObj.historyList.findPosIndex[lwcliObj.historyList.findPos];
         }
     }
-    uint8_t historyCommandLen = 0;
+    uint16_t historyCommandLen = 0;
     char cmdChar = lwcliObj.historyList.buffer[historyCmdPos * lwcliObj.historyList.commandStrSize];
     while (cmdChar != '\0' && historyCommandLen < lwcliObj.historyList.commandStrSize) {
         historyCommandLen++;
         cmdChar = lwcliObj.historyList.buffer[historyCmdPos * lwcliObj.historyList.commandStrSize + historyCommandLen];
     }
-    memcpy(lwcliObj.inputBuffer, lwcliObj.historyList.buffer + (historyCmdPos * lwcliObj.historyList.commandStrSize), lwcliObj.historyList.commandStrSize);
-    lwcliObj.inputBuffer[historyCommandLen] = '\0';
-    lwcliObj.inputBufferPos = historyCommandLen;
-
-    lwcli_opt_output(ansi_clear_line, sizeof(ansi_clear_line));
-    #if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
-    lwcli_output_file_path();
-    #endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
-    lwcli_opt_output(lwcliObj.inputBuffer, lwcliObj.inputBufferPos);
-    lwcliObj.cursorPos = lwcliObj.inputBufferPos;
+    lwcli_input_replace(lwcliObj.historyList.buffer + (historyCmdPos * lwcliObj.historyList.commandStrSize), historyCommandLen);
 
 }
 
-            #endif  // LWCLI_HISTORY_COMMAND_NUM > 0
+#endif  // LWCLI_HISTORY_COMMAND_NUM > 0
 
 #if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
 
@@ -0,0 +1,113 @@
+/**
+ * @file lwcli_string.c
+ * @author GYM (48060945@qq.com)
+ * @brief lwcli 内部字符串内核（SWAR 按字处理 / 逐字节回退）
+ * @version V0.0.4
+ * @date 2026-03-15
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "lwcli_string.h"
+#include <string.h>
+
+#if (LWCLI_STRING_SWAR == LWCLI_TRUE)
+
+#if (UINTPTR_MAX > 0xFFFFFFFFu)
+typedef uint64_t lwcli_word_t;
+#else
+typedef uint32_t lwcli_word_t;
+#endif
+
+#define LWCLI_WORD_SIZE         ((uint16_t)sizeof(lwcli_word_t))
+#define LWCLI_WORD_ONES         ((lwcli_word_t)-1 / 0xFF)           /**< 每个字节为 0x01 */
+#define LWCLI_WORD_HIGHS        (LWCLI_WORD_ONES * 0x80)            /**< 每个字节为 0x80 */
+#define LWCLI_WORD_REPEAT(c)    (LWCLI_WORD_ONES * (uint8_t)(c))    /**< 每个字节为 c */
+/** 字中存在为 0 的字节时非 0 */
+#define LWCLI_WORD_HAS_ZERO(v)  (((v) - LWCLI_WORD_ONES) & ~(v) & LWCLI_WORD_HIGHS)
+
+/**
+ * @brief 读取一个字，不要求对齐（编译器优化为单条 load）
+ */
+static inline lwcli_word_t lwcli_word_load(const char *p)
+{
+    lwcli_word_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+#endif  // LWCLI_STRING_SWAR == LWCLI_TRUE
+
+uint16_t lwcli_str_skip(const char *s, uint16_t len, char c)
+{
+    uint16_t i = 0;
+#if (LWCLI_STRING_SWAR == LWCLI_TRUE)
+    lwcli_word_t pattern = LWCLI_WORD_REPEAT(c);
+    while (i + LWCLI_WORD_SIZE <= len && lwcli_word_load(s + i) == pattern) {
+        i += LWCLI_WORD_SIZE;
+    }
+#endif  // LWCLI_STRING_SWAR == LWCLI_TRUE
+    while (i < len && s[i] == c) {
+        i++;
+    }
+    return i;
+}
+
+uint16_t lwcli_str_find(const char *s, uint16_t len, char c)
+{
+    uint16_t i = 0;
+#if (LWCLI_STRING_SWAR == LWCLI_TRUE)
+    lwcli_word_t pattern = LWCLI_WORD_REPEAT(c);
+    while (i + LWCLI_WORD_SIZE <= len) {
+        lwcli_word_t w = lwcli_word_load(s + i) ^ pattern;
+        if (LWCLI_WORD_HAS_ZERO(w)) {
+            break;
+        }
+        i += LWCLI_WORD_SIZE;
+    }
+#endif  // LWCLI_STRING_SWAR == LWCLI_TRUE
+    while (i < len && s[i] != c) {
+        i++;
+    }
+    return i;
+}
+
+uint16_t lwcli_str_find3(const char *s, uint16_t len, char a, char b, char c)
+{
+    uint16_t i = 0;
+#if (LWCLI_STRING_SWAR == LWCLI_TRUE)
+    lwcli_word_t pa = LWCLI_WORD_REPEAT(a), pb = LWCLI_WORD_REPEAT(b), pc = LWCLI_WORD_REPEAT(c);
+    while (i + LWCLI_WORD_SIZE <= len) {
+        lwcli_word_t w = lwcli_word_load(s + i);
+        if (LWCLI_WORD_HAS_ZERO(w ^ pa) | LWCLI_WORD_HAS_ZERO(w ^ pb) | LWCLI_WORD_HAS_ZERO(w ^ pc)) {
+            break;
+        }
+        i += LWCLI_WORD_SIZE;
+    }
+#endif  // LWCLI_STRING_SWAR == LWCLI_TRUE
+    while (i < len && s[i] != a && s[i] != b && s[i] != c) {
+        i++;
+    }
+    return i;
+}
+
+uint16_t lwcli_str_mismatch(const char *a, const char *b, uint16_t len)
+{
+    uint16_t i = 0;
+#if (LWCLI_STRING_SWAR == LWCLI_TRUE)
+    while (i + LWCLI_WORD_SIZE <= len && lwcli_word_load(a + i) == lwcli_word_load(b + i)) {
+        i += LWCLI_WORD_SIZE;
+    }
+#endif  // LWCLI_STRING_SWAR == LWCLI_TRUE
+    while (i < len && a[i] == b[i]) {
+        i++;
+    }
+    return i;
+}
+
+int lwcli_str_compare(const char *a, const char *b, uint16_t len)
+{
+    uint16_t i = lwcli_str_mismatch(a, b, len);
+    return (i == len) ? 0 : (int)(uint8_t)a[i] - (int)(uint8_t)b[i];
+}
@@ -0,0 +1,151 @@
+/**
+ * @file bench_string.c
+ * @brief lwcli_string 内核基准：长输入行与大候选集上 SWAR 与逐字节实现的耗时对比
+ *
+ * 不作为 ctest 检查。以 -DLWCLI_BUILD_BENCHMARKS=ON 配置后单独运行 bench_string，
+ * 每项取多轮中的最短耗时。
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "string_kernels.h"
+
+#define LINE_LEN        4096    /**< 长输入行：粘贴的整段参数 */
+#define WORD_LEN        16      /**< 分词测试中每个参数的长度 */
+#define CANDIDATE_NUM   1024    /**< 大候选集：补全时参与比较的命令名个数 */
+#define NAME_LEN        32      /**< 候选名长度，前 24 个字节相同 */
+#define PREFIX_LEN      28      /**< 已输入的补全前缀长度 */
+#define ROUNDS          7
+#define MIN_TIME_NS     20e6    /**< 每轮至少运行的时间 */
+
+typedef struct
+{
+    const char *name;
+    uint16_t (*skip)(const char *s, uint16_t len, char c);
+    uint16_t (*find)(const char *s, uint16_t len, char c);
+    uint16_t (*find3)(const char *s, uint16_t len, char a, char b, char c);
+    uint16_t (*mismatch)(const char *a, const char *b, uint16_t len);
+    int (*compare)(const char *a, const char *b, uint16_t len);
+}kernels_t;
+
+static const kernels_t kernels[2] = {
+    {"bytewise", byte_skip, byte_find, byte_find3, byte_mismatch, byte_compare},
+    {"SWAR", swar_skip, swar_find, swar_find3, swar_mismatch, swar_compare},
+};
+
+static char blob[LINE_LEN];                         /* 不含分隔符的长参数 */
+static char words[LINE_LEN];                        /* 以单个空格分隔的参数 */
+static char spaces[LINE_LEN];                       /* 连续空格 */
+static char names[CANDIDATE_NUM][NAME_LEN];         /* 候选命令名 */
+static volatile uint32_t sink;                      /* 防止结果被优化掉 */
+
+/** 在长参数中查找空格、引号或反斜杠（解析器跳过参数正文） */
+static uint32_t bench_find3(const kernels_t *k)
+{
+    return k->find3(blob, LINE_LEN, ' ', '"', '\\');
+}
+
+/** 逐个参数分词：跳过空格再查找下一个空格 */
+static uint32_t bench_tokenize(const kernels_t *k)
+{
+    uint32_t tokens = 0;
+    uint16_t pos = 0;
+    while (pos < LINE_LEN) {
+        pos += k->skip(words + pos, LINE_LEN - pos, ' ');
+        pos += k->find(words + pos, LINE_LEN - pos, ' ');
+        tokens++;
+    }
+    return tokens;
+}
+
+/** 跳过连续空格 */
+static uint32_t bench_skip(const kernels_t *k)
+{
+    return k->skip(spaces, LINE_LEN, ' ');
+}
+
+/** 已输入前缀与每个候选名比较（补全时确定匹配区间） */
+static uint32_t bench_prefix(const kernels_t *k)
+{
+    uint32_t match = 0;
+    for (int i = 0; i < CANDIDATE_NUM; i++) {
+        match += (k->compare(names[CANDIDATE_NUM / 2], names[i], PREFIX_LEN) == 0);
+    }
+    return match;
+}
+
+/** 全部候选名的最长公共前缀 */
+static uint32_t bench_common_prefix(const kernels_t *k)
+{
+    uint16_t common = NAME_LEN;
+    for (int i = 1; i < CANDIDATE_NUM; i++) {
+        common = k->mismatch(names[0], names[i], common);
+    }
+    return common;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief 测量一次调用的耗时
+ * @return 多轮中每次调用的最短平均耗时（ns）
+ */
+static double measure(uint32_t (*bench)(const kernels_t *k), const kernels_t *k)
+{
+    double best = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        long calls = 0;
+        double start = now_ns(), elapsed;
+        do {
+            for (int i = 0; i < 64; i++) {
+                sink += bench(k);
+            }
+            calls += 64;
+            elapsed = now_ns() - start;
+        } while (elapsed < MIN_TIME_NS);
+        double per_call = elapsed / calls;
+        if (round == 0 || per_call < best) {
+            best = per_call;
+        }
+    }
+    return best;
+}
+
+int main(void)
+{
+    static const struct {
+        const char *name;
+        uint32_t (*bench)(const kernels_t *k);
+    } benches[] = {
+        {"find3, 4 KB argument", bench_find3},
+        {"tokenize, 4 KB line of 16-byte words", bench_tokenize},
+        {"skip, 4 KB of spaces", bench_skip},
+        {"prefix compare, 1024 candidates", bench_prefix},
+        {"common prefix, 1024 candidates", bench_common_prefix},
+    };
+
+    for (int i = 0; i < LINE_LEN; i++) {
+        blob[i] = (char)('A' + i % 26);
+        words[i] = ((i + 1) % (WORD_LEN + 1) == 0) ? ' ' : (char)('a' + i % 26);
+        spaces[i] = ' ';
+    }
+    for (int i = 0; i < CANDIDATE_NUM; i++) {
+        snprintf(names[i], NAME_LEN, "manufacturing_test_step_%04d", i);
+    }
+
+    printf("%-40s %12s %12s %8s\n", "", kernels[0].name, kernels[1].name, "speedup");
+    for (size_t b = 0; b < sizeof(benches) / sizeof(benches[0]); b++) {
+        double byte_ns = measure(benches[b].bench, &kernels[0]);
+        double swar_ns = measure(benches[b].bench, &kernels[1]);
+        printf("%-40s %9.1f ns %9.1f ns %7.2fx\n", benches[b].name, byte_ns, swar_ns, byte_ns / swar_ns);
+    }
+    return 0;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file string_kernels.h
+ * @brief 同时编译 lwcli_string.c 的 SWAR 与逐字节两种实现，函数分别改名为 swar_* 与 byte_*
+ */
+
+#ifndef __LWCLI_TEST_STRING_KERNELS_H__
+#define __LWCLI_TEST_STRING_KERNELS_H__
+
+#include "lwcli_config.h"
+
+#undef LWCLI_STRING_SWAR
+#define LWCLI_STRING_SWAR LWCLI_TRUE
+#define lwcli_str_skip      swar_skip
+#define lwcli_str_find      swar_find
+#define lwcli_str_find3     swar_find3
+#define lwcli_str_mismatch  swar_mismatch
+#define lwcli_str_compare   swar_compare
+#include "../src/lwcli_string.c"
+#undef lwcli_str_skip
+#undef lwcli_str_find
+#undef lwcli_str_find3
+#undef lwcli_str_mismatch
+#undef lwcli_str_compare
+
+#undef LWCLI_STRING_SWAR
+#define LWCLI_STRING_SWAR LWCLI_FALSE
+#define lwcli_str_skip      byte_skip
+#define lwcli_str_find      byte_find
+#define lwcli_str_find3     byte_find3
+#define lwcli_str_mismatch  byte_mismatch
+#define lwcli_str_compare   byte_compare
+#include "../src/lwcli_string.c"
+#undef lwcli_str_skip
+#undef lwcli_str_find
+#undef lwcli_str_find3
+#undef lwcli_str_mismatch
+#undef lwcli_str_compare
+
+#endif /* __LWCLI_TEST_STRING_KERNELS_H__ */
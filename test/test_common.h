@@ -0,0 +1,79 @@
+/**
+ * @file test_common.h
+ * @brief 主机测试公用部分：检查宏、结果汇总，以及包含 lwcli.h 时的 lwcli 初始化
+ */
+
+#ifndef __LWCLI_TEST_COMMON_H__
+#define __LWCLI_TEST_COMMON_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static int failures;
+
+/** 条件不成立时记录一次失败并打印位置与说明，测试继续执行 */
+#define CHECK(cond, ...) do {                       \
+        if (!(cond)) {                              \
+            failures++;                             \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__);                    \
+            printf("\n");                           \
+        }                                           \
+    } while (0)
+
+/**
+ * @brief 打印测试结果
+ * @param name 测试名
+ * @return 作为 main 的返回值，全部通过为 0
+ */
+static inline int test_report(const char *name)
+{
+    if (failures) {
+        printf("%s: %d failures\n", name, failures);
+        return 1;
+    }
+    printf("%s: ok\n", name);
+    return 0;
+}
+
+#ifdef LWCLI_LWCLI_H
+static size_t test_malloc_calls;    /**< lwcli 调用 malloc 的次数 */
+
+static inline void *test_malloc(size_t size)
+{
+    test_malloc_calls++;
+    return malloc(size);
+}
+
+static inline void test_free(void *p)
+{
+    free(p);
+}
+
+#if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
+static inline char *test_path(void)
+{
+    return "/";
+}
+#endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
+
+/**
+ * @brief 以 output 作为终端输出初始化 lwcli
+ * @param output 输出函数
+ */
+static inline void test_lwcli_init(void (*output)(const char *str, uint16_t len))
+{
+    static lwcli_opt_t opt;
+    opt.malloc = test_malloc;
+    opt.free = test_free;
+    opt.output = output;
+    opt.hardware_init = NULL;
+#if (LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE)
+    opt.get_file_path = test_path;
+#endif  // LWCLI_WITH_FILE_SYSTEM == LWCLI_TRUE
+    lwcli_hardware_init(&opt);
+    lwcli_software_init();
+}
+#endif  // LWCLI_LWCLI_H
+
+#endif /* __LWCLI_TEST_COMMON_H__ */
@@ -0,0 +1,146 @@
+/**
+ * @file test_deferred.c
+ * @brief LWCLI_DEFERRED_INPUT 测试：接收路径每字节的最坏开销为常数
+ *
+ * 测试直接包含 lwcli.c，对每个收到的字节比较 lwcliObj 前后的完整快照：不论字节种类、
+ * 输入行长度、命令数量与编辑状态，接收函数只改写环形缓冲区的一个字节和写位置
+ * （缓冲区满时什么都不改），并且不输出、不分配内存、不调用回调。
+ * 该上界是确定的，不依赖计时；处理推迟到 lwcli_poll() 后再检查结果。
+ */
+
+#include "../src/lwcli.c"
+#include "test_common.h"
+
+#include <string.h>
+
+#define COMMAND_NUM     200     /**< 注册的命令数，Tab 时全部为候选 */
+
+static size_t output_calls, callback_calls, hotkey_calls;
+static size_t checked_bytes;
+static char last_arg[64];
+static lwcli_t snapshot;
+
+static void test_output(const char *str, uint16_t len)
+{
+    (void)str;
+    (void)len;
+    output_calls++;
+}
+
+static void test_command(int argc, char *argv[], const uint16_t argl[])
+{
+    callback_calls++;
+    if (argc > 0 && argl[0] < sizeof(last_arg)) {
+        memcpy(last_arg, argv[0], argl[0]);
+        last_arg[argl[0]] = '\0';
+    }
+}
+
+static void test_hotkey(uint8_t key)
+{
+    (void)key;
+    hotkey_calls++;
+}
+
+static size_t work_calls(void)
+{
+    return output_calls + test_malloc_calls + callback_calls + hotkey_calls;
+}
+
+/**
+ * @brief 计算把 data 写入 snapshot 的环形缓冲区后的预期状态
+ */
+static void expect_ring_put(const char *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        uint16_t next = (snapshot.ringHead + 1) & (LWCLI_INPUT_RING_SIZE - 1);
+        if (next == snapshot.ringTail) {
+            break;
+        }
+        snapshot.ring[snapshot.ringHead] = data[i];
+        snapshot.ringHead = next;
+    }
+}
+
+/**
+ * @brief 逐字节调用 lwcli_process_receive_char()，检查每字节的全部副作用
+ */
+static void receive_checked(const char *what, const char *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        size_t calls = work_calls();
+        memcpy(&snapshot, (const void *)&lwcliObj, sizeof(snapshot));
+        expect_ring_put(data + i, 1);
+        lwcli_process_receive_char(data[i]);
+        CHECK(memcmp(&snapshot, (const void *)&lwcliObj, sizeof(snapshot)) == 0,
+              "%s: byte %zu (0x%02x) changed state other than one ring slot and ringHead", what, i, (uint8_t)data[i]);
+        CHECK(work_calls() == calls, "%s: byte %zu (0x%02x) did output, allocation or callbacks", what, i, (uint8_t)data[i]);
+        checked_bytes++;
+    }
+}
+
+/**
+ * @brief 整块调用 lwcli_process_receive_buffer()，检查副作用只有写入环形缓冲区
+ */
+static void receive_buffer_checked(const char *what, const char *data, size_t len)
+{
+    size_t calls = work_calls();
+    memcpy(&snapshot, (const void *)&lwcliObj, sizeof(snapshot));
+    expect_ring_put(data, len);
+    lwcli_process_receive_buffer(data, len);
+    CHECK(memcmp(&snapshot, (const void *)&lwcliObj, sizeof(snapshot)) == 0, "%s: state changed outside the ring", what);
+    CHECK(work_calls() == calls, "%s: receive did output, allocation or callbacks", what);
+}
+
+int main(void)
+{
+    test_lwcli_init(test_output);
+    for (int i = 0; i < COMMAND_NUM; i++) {
+        static char names[COMMAND_NUM][8];
+        snprintf(names[i], sizeof(names[i]), "cmd%03d", i);
+        lwcli_regist_command(names[i], "test command", test_command);
+    }
+    lwcli_regist_hotkey(LWCLI_HOTKEY_CTRL('t'), test_hotkey);
+    lwcli_poll();
+
+    /* 接近满的输入行，光标在行首附近：立即模式下每个编辑键都要移动并重绘整行 */
+    static char long_line[LWCLI_RECEIVE_BUFFER_SIZE];
+    memset(long_line, 'a', sizeof(long_line));
+    memcpy(long_line, "cmd000 ", 7);
+    lwcli_process_receive_buffer(long_line, LWCLI_RECEIVE_BUFFER_SIZE - 8);
+    lwcli_process_receive_buffer("\033[H\033[C\033[C\033[C\033[C\033[C\033[C\033[C\033[C", 27);
+    lwcli_poll();
+    static const char edits[] = "z\177\033[3~\033[C\033[1;5C\t\033[A\033[B\x14\033[F\r";
+    receive_checked("editing a long line", edits, sizeof(edits) - 1);
+    CHECK(callback_calls == 0 && hotkey_calls == 0, "callbacks ran before lwcli_poll()");
+    lwcli_poll();
+    CHECK(callback_calls == 1 && hotkey_calls == 1, "expected 1 command and 1 hotkey after poll, got %zu and %zu",
+          callback_calls, hotkey_calls);
+
+    /* 所有命令都是候选的 Tab 补全 */
+    receive_checked("Tab over all commands", "cmd\t\t\177\177\177", 8);
+    size_t before = output_calls;
+    lwcli_poll();
+    CHECK(output_calls > before, "Tab produced no output after poll");
+
+    /* 粘贴的多行命令 */
+    static const char paste[] = "\033[200~cmd001 p1\rcmd002 p2\r\033[201~";
+    receive_checked("bracketed paste", paste, sizeof(paste) - 1);
+    receive_buffer_checked("bracketed paste, buffer", paste, sizeof(paste) - 1);
+    lwcli_poll();
+    CHECK(callback_calls == 5 && strcmp(last_arg, "p2") == 0, "pasted commands not dispatched");
+
+    /* 缓冲区满时丢弃后续数据，已写入的内容保持完整 */
+    static char flood[LWCLI_INPUT_RING_SIZE + 16];
+    memset(flood, 'x', sizeof(flood));
+    memcpy(flood, "cmd003 keep\r", 12);
+    receive_checked("ring overflow", flood, sizeof(flood));
+    receive_buffer_checked("ring overflow, buffer", "cmd004 lost\r", 12);
+    lwcli_poll();
+    CHECK(callback_calls == 6 && strcmp(last_arg, "keep") == 0, "ring overflow corrupted queued input");
+    lwcli_process_receive_buffer("\r", 1);
+    lwcli_poll();
+
+    printf("%zu received bytes each wrote one ring slot and ringHead only\n", checked_bytes);
+    return test_report("test_deferred");
+}
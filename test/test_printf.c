@@ -0,0 +1,143 @@
+/**
+ * @file test_printf.c
+ * @brief lwcli_printf 测试：支持的转换与 snprintf 输出一致，截断的转换说明不越界读取
+ *
+ * 测试直接包含 lwcli.c，比较内部格式化函数 lwcli_vprintf() 的输出。
+ * 分别以默认子集与 LWCLI_PRINTF_EXTENDED 构建。
+ */
+
+#include "../src/lwcli.c"
+#include "test_common.h"
+
+#include <stdarg.h>
+#include <string.h>
+#include <limits.h>
+
+static char captured[4096];
+static size_t captured_len;
+
+static void test_output(const char *str, uint16_t len)
+{
+    if (captured_len + len < sizeof(captured)) {
+        memcpy(captured + captured_len, str, len);
+    }
+    captured_len += len;
+}
+
+static const char *capture(const char *format, va_list args)
+{
+    captured_len = 0;
+    lwcli_vprintf(format, args);
+    captured[captured_len < sizeof(captured) ? captured_len : sizeof(captured) - 1] = '\0';
+    return captured;
+}
+
+/* 与 snprintf 比较 */
+static void check(const char *format, ...)
+{
+    char expected[4096];
+    va_list args, copy;
+    va_start(args, format);
+    va_copy(copy, args);
+    vsnprintf(expected, sizeof(expected), format, copy);
+    va_end(copy);
+    const char *actual = capture(format, args);
+    va_end(args);
+    if (strcmp(actual, expected) != 0) {
+        failures++;
+        printf("FAIL \"%s\": expected \"%s\", got \"%s\"\n", format, expected, actual);
+    }
+}
+
+/* 与给定结果比较（snprintf 未定义或不支持的情况） */
+static void check_literal(const char *expected, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    const char *actual = capture(format, args);
+    va_end(args);
+    if (strcmp(actual, expected) != 0) {
+        failures++;
+        printf("FAIL \"%s\": expected \"%s\", got \"%s\"\n", format, expected, actual);
+    }
+}
+
+int main(void)
+{
+    test_lwcli_init(test_output);
+
+    /* 整数 */
+    static const int ints[] = {0, 1, -1, 7, 42, -42, 255, 65535, INT_MAX, INT_MIN};
+    static const char *const int_formats[] = {
+        "%d", "%i", "%5d", "%-5d|", "%05d", "%+d", "% d", "%+5d", "%-+6d|", "% 05d", "%+ d",
+        "%u", "%x", "%X", "%o", "%08x", "%hd", "%hu", "%hhd", "%hhu", "%hx",
+#if (LWCLI_PRINTF_EXTENDED == LWCLI_TRUE)
+        "%.3d", "%8.3d", "%-8.3d|", "%08.3d", "%.0d", "%5.0d", "%+.0d",
+        "%#x", "%#X", "%#o", "%#08x", "%#.4x", "%.0x", "%#.0o",
+#endif  // LWCLI_PRINTF_EXTENDED == LWCLI_TRUE
+    };
+    for (size_t f = 0; f < sizeof(int_formats) / sizeof(int_formats[0]); f++) {
+        for (size_t i = 0; i < sizeof(ints) / sizeof(ints[0]); i++) {
+            check(int_formats[f], ints[i]);
+        }
+    }
+    check("%ld %lu %lx %li", LONG_MIN, ULONG_MAX, ULONG_MAX, LONG_MAX);
+    check("%zu %zx %zd", (size_t)123456, (size_t)0xBEEF, (size_t)77);
+    check("%*d|%-*d|%*d", 6, 12, 6, 12, -6, 12);
+#if (LWCLI_PRINTF_EXTENDED == LWCLI_TRUE)
+    check("%lld %llu %llx %llo %+lld", LLONG_MIN, ULLONG_MAX, ULLONG_MAX, ULLONG_MAX, 12345678901234LL);
+    check("%.*d|%.*d|%*.*x", 5, 12, -3, 12, 8, 4, 0xAB);
+#else
+    /* 子集：ll 取走参数后原样输出，整数精度与 '#' 被忽略，后续参数不错位 */
+    check_literal("%lld 5 %-8llx| 6", "%lld %d %-8llx| %d", LLONG_MIN, 5, ULLONG_MAX, 6);
+    check_literal("12|   12|ab", "%.*d|%5.3d|%#x", 5, 12, 12, 0xAB);
+#endif  // LWCLI_PRINTF_EXTENDED == LWCLI_TRUE
+    check("%p", (void *)0x1234);
+
+    /* 字符与字符串 */
+    check("%c|%3c|%-3c|", 'a', 'b', 'c');
+    check("%s|%8s|%-8s|%.2s|%8.2s|%-8.2s|", "abc", "abc", "abc", "abc", "abc", "abc");
+    check("%.*s|%*s|%-*s|", 2, "hello", 7, "hi", -7, "hi");
+    check("%.10s|%.0s|", "short", "gone");
+    check("100%% %s %d%%", "done", 50);
+    check("%s", "");
+    check_literal("(null)", "%s", (const char *)NULL);
+
+    /* 长输出跨越分块缓冲区 */
+    char long_str[1500];
+    memset(long_str, 'z', sizeof(long_str) - 1);
+    long_str[sizeof(long_str) - 1] = '\0';
+    check("[%s] %d [%-1600s]", long_str, 99, "pad");
+    check("%0200d|%-300x|", 5, 0xabc);
+
+    /* 超过 65535 字节的字符串完整输出 */
+    static char huge[70001];
+    memset(huge, 'h', sizeof(huge) - 1);
+    captured_len = 0;
+    lwcli_printf("[%s]", huge);
+    CHECK(captured_len == sizeof(huge) + 1, "%%s of %zu bytes wrote %zu", sizeof(huge) - 1, captured_len);
+
+    /* 参数顺序：各种标志与长度修饰之后的参数不错位 */
+#if (LWCLI_PRINTF_EXTENDED == LWCLI_TRUE)
+    check("%+d % d %d %s %#x %c %lld %hhu %zu", 1, 2, 3, "x", 4, 'y', 5LL, 300, (size_t)6);
+#else
+    check("%+d % d %d %s %x %c %ld %hhu %zu", 1, 2, 3, "x", 4, 'y', 5L, 300, (size_t)6);
+#endif  // LWCLI_PRINTF_EXTENDED == LWCLI_TRUE
+
+    /* 不支持的转换：浮点取走参数，其他原样输出 */
+    check_literal("%f after 7", "%f after %d", 1.5, 7);
+    check_literal("%.2e 3", "%.2e %d", 2.5, 3);
+    check_literal("%q 1", "%q %d", 1);
+
+    /* 截断的转换说明原样输出，不越过 '\0' 读取 */
+    check_literal("a%", "a%");
+    check_literal("a%5", "a%5");
+    check_literal("%l", "%l");
+    check_literal("%ll", "%ll");
+    check_literal("%-", "%-");
+    check_literal("%.", "%.");
+    check_literal("x%+08.3h", "x%+08.3h");
+    check_literal("7 %", "%d %", 7);
+
+    return test_report("test_printf");
+}
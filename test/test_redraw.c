@@ -0,0 +1,170 @@
+/**
+ * @file test_redraw.c
+ * @brief 输入行重绘测试：历史切换、Tab 补全与行中编辑只输出变化的部分
+ *
+ * 输出送入一个单行 VT100 终端模型，每一步检查屏幕内容与光标位置正确，
+ * 并检查输出字节数等于预期值、少于整行重绘（清行 + 提示符 + 整行内容），且不含 '\0'。
+ */
+
+#include "lwcli.h"
+#include "test_common.h"
+
+#include <string.h>
+
+#define SCREEN_WIDTH    256
+
+/** 单行终端模型：支持可见字符、\r、\n、\b 与 CSI C/D/K/s/u/m/h */
+static struct {
+    char line[SCREEN_WIDTH];
+    int cursor;
+    int saved;
+    int state;          /* 0 普通，1 收到 ESC，2 CSI 中 */
+    int param;
+    size_t bytes;
+    size_t line_bytes;  /* 最后一个 '\n' 之后的字节数 */
+    size_t nul_bytes;
+} term;
+
+static void term_clear(int from)
+{
+    memset(term.line + from, ' ', SCREEN_WIDTH - from);
+}
+
+static void term_feed(char c)
+{
+    term.line_bytes++;
+    if (term.state == 1) {
+        term.state = (c == '[') ? 2 : 0;
+        term.param = -1;
+        return;
+    }
+    if (term.state == 2) {
+        if (c >= '0' && c <= '9') {
+            term.param = (term.param < 0 ? 0 : term.param * 10) + (c - '0');
+            return;
+        }
+        if (c == ';' || c == '?') {
+            return;
+        }
+        int n = (term.param < 0) ? 1 : term.param;
+        term.state = 0;
+        switch (c) {
+        case 'C': term.cursor += n; break;
+        case 'D': term.cursor = (term.cursor > n) ? term.cursor - n : 0; break;
+        case 'K': term_clear((term.param == 2) ? 0 : term.cursor); break;
+        case 's': term.saved = term.cursor; break;
+        case 'u': term.cursor = term.saved; break;
+        default: break;     /* m（颜色）、h（模式）等不影响内容 */
+        }
+        return;
+    }
+    switch (c) {
+    case '\033': term.state = 1; break;
+    case '\r': term.cursor = 0; break;
+    case '\n': term_clear(0); term.line_bytes = 0; return;
+    case '\b': if (term.cursor > 0) term.cursor--; break;
+    case '\0': term.nul_bytes++; break;
+    default:
+        if (term.cursor < SCREEN_WIDTH) {
+            term.line[term.cursor] = c;
+        }
+        term.cursor++;
+        break;
+    }
+}
+
+static void test_output(const char *str, uint16_t len)
+{
+    term.bytes += len;
+    for (uint16_t i = 0; i < len; i++) {
+        term_feed(str[i]);
+    }
+}
+
+static void test_command(int argc, char *argv[], const uint16_t argl[])
+{
+    (void)argc;
+    (void)argv;
+    (void)argl;
+}
+
+static int prompt_len;          /* 提示符在屏幕上的宽度 */
+static size_t prompt_bytes;     /* 输出一次提示符的字节数（含颜色） */
+
+/**
+ * @brief 输入 keys，检查屏幕显示 prompt + text、光标位于 text 的第 cursor 个字符，并检查输出字节数
+ */
+static void step(const char *name, const char *keys, const char *text, int cursor, size_t expected_bytes)
+{
+    term.bytes = 0;
+    term.nul_bytes = 0;
+    lwcli_process_receive_buffer(keys, strlen(keys));
+
+    char shown[SCREEN_WIDTH + 1];
+    int end = SCREEN_WIDTH;
+    while (end > prompt_len && term.line[end - 1] == ' ') {
+        end--;
+    }
+    memcpy(shown, term.line + prompt_len, end - prompt_len);
+    shown[end - prompt_len] = '\0';
+    /* 模型不区分行尾空格与空白，比较时去掉 text 的行尾空格 */
+    size_t text_len = strlen(text);
+    while (text_len > 0 && text[text_len - 1] == ' ') {
+        text_len--;
+    }
+    /* 整行重绘：清行（5 字节）+ 提示符 + 内容 */
+    size_t full_bytes = 5 + prompt_bytes + strlen(text);
+
+    printf("%-28s %3zu bytes (full redraw %3zu)\n", name, term.bytes, full_bytes);
+    CHECK(strlen(shown) == text_len && memcmp(shown, text, text_len) == 0, "%s: screen shows \"%s\", expected \"%s\"", name, shown, text);
+    CHECK(term.cursor == prompt_len + cursor, "%s: cursor at %d, expected %d", name, term.cursor - prompt_len, cursor);
+    CHECK(term.nul_bytes == 0, "%s: %zu NUL bytes sent", name, term.nul_bytes);
+    CHECK(term.bytes == expected_bytes, "%s: %zu bytes sent, expected %zu", name, term.bytes, expected_bytes);
+    CHECK(expected_bytes == 0 || term.bytes < full_bytes, "%s: %zu bytes is not less than a full redraw (%zu)", name, term.bytes, full_bytes);
+}
+
+int main(void)
+{
+    term_clear(0);
+    test_lwcli_init(test_output);
+    int fd = lwcli_regist_command("status", "show status", test_command);
+    lwcli_regist_command_parameter(fd, "--verbose", "verbose output");
+    lwcli_regist_command("stats", "show statistics", test_command);
+    lwcli_regist_command("reboot", "reboot system", test_command);
+
+    /* 空行回车后最后一行只有提示符 */
+    lwcli_process_receive_buffer("\r", 1);
+    prompt_bytes = term.line_bytes;
+    prompt_len = term.cursor;
+
+    static const char *const commands[] = {"status --verbose now\r", "stats\r", "reboot\r"};
+    for (size_t i = 0; i < sizeof(commands) / sizeof(commands[0]); i++) {
+        lwcli_process_receive_buffer(commands[i], strlen(commands[i]));
+    }
+
+    /* 历史切换：只输出与上一条不同的尾部 */
+    step("history up: reboot",   "\033[A", "reboot", 6, 6);
+    step("history up: stats",    "\033[A", "stats", 5, 11);
+    step("history up: status",   "\033[A", "status --verbose now", 20, 17);
+    step("history down: stats",  "\033[B", "stats", 5, 9);
+    step("history down: reboot", "\033[B", "reboot", 6, 10);
+    step("backspace x6",         "\177\177\177\177\177\177", "", 0, 18);
+
+    /* Tab 补全：只输出补全出的字符 */
+    step("type statu",           "statu", "statu", 5, 5);
+    step("tab: command",         "\t", "status ", 7, 2);
+    step("type --v",             "--v", "status --v", 10, 3);
+    step("tab: parameter",       "\t", "status --verbose ", 17, 7);
+
+    /* 行中编辑 */
+    step("home",                 "\033[H", "status --verbose ", 0, 5);
+    step("right x3",             "\033[C\033[C\033[C", "status --verbose ", 3, 9);
+    step("insert X",             "X", "staXtus --verbose ", 4, 20);
+    step("backspace mid-line",   "\177", "status --verbose ", 3, 21);
+    step("delete mid-line",      "\033[3~", "staus --verbose ", 3, 19);
+    step("left x3",              "\033[D\033[D\033[D", "staus --verbose ", 0, 3);
+    step("end",                  "\033[F", "staus --verbose ", 16, 5);
+    step("backspace at end",     "\177", "staus --verbose", 15, 3);
+
+    return test_report("test_redraw");
+}
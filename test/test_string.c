@@ -0,0 +1,94 @@
+/**
+ * @file test_string.c
+ * @brief lwcli_string 内核测试：SWAR 与逐字节实现在各种对齐与尾部长度下结果一致
+ *
+ * string_kernels.h 把同一个 lwcli_string.c 以两种 LWCLI_STRING_SWAR 配置各编译一次，逐一比较结果。
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "string_kernels.h"
+#include "test_common.h"
+
+#define MAX_OFFSET  16
+#define MAX_LEN     80
+
+static int sign(int v)
+{
+    return (v > 0) - (v < 0);
+}
+
+/* 按 len 取字节，len 之外填入目标字节，检查内核不会越过 len */
+static void fill(char *buf, int len, const char *alphabet, char guard)
+{
+    int n = (int)strlen(alphabet);
+    for (int i = 0; i < len; i++) {
+        buf[i] = alphabet[rand() % n];
+    }
+    for (int i = len; i < len + 16; i++) {
+        buf[i] = guard;
+    }
+}
+
+static void check_scan(const char *s, uint16_t len, int off)
+{
+    static const char targets[] = {' ', '"', '\\', 'a', '\x80', '\xff'};
+    for (size_t t = 0; t < sizeof(targets); t++) {
+        char c = targets[t];
+        CHECK(swar_skip(s, len, c) == byte_skip(s, len, c), "skip off=%d len=%u c=%02x", off, len, (uint8_t)c);
+        CHECK(swar_find(s, len, c) == byte_find(s, len, c), "find off=%d len=%u c=%02x", off, len, (uint8_t)c);
+    }
+    CHECK(swar_find3(s, len, ' ', '"', '\\') == byte_find3(s, len, ' ', '"', '\\'), "find3 off=%d len=%u", off, len);
+    CHECK(swar_find3(s, len, '\x80', 'z', '\xff') == byte_find3(s, len, '\x80', 'z', '\xff'), "find3 high off=%d len=%u", off, len);
+}
+
+static void check_compare(const char *a, const char *b, uint16_t len, int off_a, int off_b)
+{
+    CHECK(swar_mismatch(a, b, len) == byte_mismatch(a, b, len), "mismatch off=%d/%d len=%u", off_a, off_b, len);
+    CHECK(sign(swar_compare(a, b, len)) == sign(byte_compare(a, b, len)), "compare off=%d/%d len=%u", off_a, off_b, len);
+    CHECK(sign(swar_compare(a, b, len)) == sign(memcmp(a, b, len)), "compare vs memcmp off=%d/%d len=%u", off_a, off_b, len);
+}
+
+int main(void)
+{
+    static const char *const alphabets[] = {
+        " ",                /* 全部为空格：skip 走完整个字 */
+        "ab",               /* 没有目标字节：find 走完整个字 */
+        "  ab\"\\",         /* 混合 */
+        "\x80\xff a",       /* 高位字节，检查 SWAR 零字节判断的误报 */
+    };
+    char buf_a[MAX_OFFSET + MAX_LEN + 16];
+    char buf_b[MAX_OFFSET + MAX_LEN + 16];
+    srand(1);
+
+    for (size_t k = 0; k < sizeof(alphabets) / sizeof(alphabets[0]); k++) {
+        for (int off = 0; off < MAX_OFFSET; off++) {
+            for (int len = 0; len <= MAX_LEN; len++) {
+                for (int round = 0; round < 4; round++) {
+                    fill(buf_a + off, len, alphabets[k], (round & 1) ? ' ' : 'x');
+                    check_scan(buf_a + off, (uint16_t)len, off);
+                }
+            }
+        }
+    }
+
+    for (int off_a = 0; off_a < MAX_OFFSET; off_a += 3) {
+        for (int off_b = 0; off_b < MAX_OFFSET; off_b++) {
+            for (int len = 0; len <= MAX_LEN; len++) {
+                for (int diff = -1; diff < len; diff++) {
+                    /* diff < 0 时两串相同，否则只在 diff 处不同 */
+                    fill(buf_a + off_a, len, "abc\x80", 'x');
+                    memcpy(buf_b + off_b, buf_a + off_a, len);
+                    memset(buf_b + off_b + len, 'y', 16);
+                    if (diff >= 0) {
+                        buf_b[off_b + diff] = (char)(buf_a[off_a + diff] ^ ((diff & 1) ? 0x01 : 0x80));
+                    }
+                    check_compare(buf_a + off_a, buf_b + off_b, (uint16_t)len, off_a, off_b);
+                }
+            }
+        }
+    }
+
+    return test_report("test_string");
+}